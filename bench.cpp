@@ -0,0 +1,499 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "bigint.hpp"
+
+using namespace std;
+
+/**
+ * @brief Benchmark suite for the BigInt class
+ * Every constructor, operator, conversion and comparison is timed over operand sizes from 1 digit up to --max-digits (10^7 at most), including asymmetric cases like huge / small
+ * Each case is repeated until it has run for at least --min-time-ms, and the results are written as JSON with the time, the number of allocations, the allocated bytes per operation and the peak of the bytes live at once
+ * Reading a number of a million digits with the operator `>>` and from_fd() is always run as well, and the benchmark fails if either has as many bytes live as the text it reads
+ *
+ * Usage: bench [--max-digits N] [--max-quadratic-digits N] [--min-time-ms T] [--filter TEXT] [--output FILE]
+ */
+
+// ---------------------------------------- allocation tracking ----------------------------------------
+
+/**
+ * @brief Counters of the replaced global operator new, read before and after each timed loop
+ * live_bytes and peak_bytes follow the bytes allocated and not yet freed, each block starts with a header that remembers its size
+ */
+
+static std::atomic<uint64_t> allocation_count{0};
+static std::atomic<uint64_t> allocated_bytes{0};
+static std::atomic<uint64_t> live_bytes{0};
+static std::atomic<uint64_t> peak_bytes{0};
+
+constexpr size_t allocation_header = alignof(std::max_align_t); // keeps the memory after the header aligned like malloc() does
+
+// all replacements are kept out of line, GCC warns about free() on memory from operator new once one of them is inlined into a caller and the other is not
+BIGINT_NOINLINE void *operator new(size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    uint64_t live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    uint64_t peak = peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        ;
+    if (void *memory = std::malloc(allocation_header + size))
+    {
+        std::memcpy(memory, &size, sizeof(size));
+        return static_cast<char *>(memory) + allocation_header;
+    }
+    throw std::bad_alloc();
+}
+
+BIGINT_NOINLINE void operator delete(void *memory) noexcept
+{
+    if (memory == nullptr)
+        return;
+    void *block = static_cast<char *>(memory) - allocation_header;
+    size_t size;
+    std::memcpy(&size, block, sizeof(size));
+    live_bytes.fetch_sub(size, std::memory_order_relaxed);
+    std::free(block);
+}
+
+BIGINT_NOINLINE void operator delete(void *memory, size_t) noexcept
+{
+    operator delete(memory);
+}
+
+// ---------------------------------------- measurement ----------------------------------------
+
+/**
+ * @brief Keeps the compiler from removing a computation whose result is otherwise unused
+ */
+
+template <typename T>
+inline void keep(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void *volatile sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief The settings given on the command line
+ */
+
+struct bench_options
+{
+    size_t max_digits = 100000;
+    size_t max_quadratic_digits = 100000;
+    double min_time_ms = 50;
+    string filter;
+    string output;
+};
+
+/**
+ * @brief One line of the JSON report
+ * operand_digits is 0 for operations with a single operand
+ */
+
+struct bench_result
+{
+    string name;
+    size_t digits;
+    size_t operand_digits;
+    uint64_t iterations;
+    double ns_per_op;
+    double allocs_per_op;
+    double bytes_per_op;
+    uint64_t peak_bytes; // the most bytes live at once during a call, above what was live before it
+};
+
+/**
+ * @brief Runs body repeatedly, growing the iteration count until the timed loop takes at least min_time_ms, and returns the cost of one call
+ * A first call warms the caches; if it alone already takes min_time_ms (huge operands), it is reported as the measurement
+ */
+
+template <typename Body>
+bench_result measure(const bench_options &options, Body &&body)
+{
+    using clock = std::chrono::steady_clock;
+    double min_time_ns = options.min_time_ms * 1e6;
+    uint64_t iterations = 1;
+    bool warm_up = true;
+
+    while (true)
+    {
+        uint64_t allocations_before = allocation_count.load(std::memory_order_relaxed);
+        uint64_t bytes_before = allocated_bytes.load(std::memory_order_relaxed);
+        uint64_t live_before = live_bytes.load(std::memory_order_relaxed);
+        peak_bytes.store(live_before, std::memory_order_relaxed);
+        clock::time_point start = clock::now();
+        for (uint64_t i = 0; i < iterations; ++i)
+            body();
+        double elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        uint64_t allocations = allocation_count.load(std::memory_order_relaxed) - allocations_before;
+        uint64_t bytes = allocated_bytes.load(std::memory_order_relaxed) - bytes_before;
+        uint64_t peak = peak_bytes.load(std::memory_order_relaxed) - live_before;
+
+        if (elapsed >= min_time_ns || iterations >= (uint64_t{1} << 32))
+            return {"", 0, 0, iterations, elapsed / static_cast<double>(iterations), static_cast<double>(allocations) / static_cast<double>(iterations), static_cast<double>(bytes) / static_cast<double>(iterations), peak};
+
+        if (warm_up)
+        {
+            warm_up = false;
+            continue;
+        }
+        // aim 20% past the minimum time so the next loop is usually the last one
+        double target = (elapsed > 0) ? static_cast<double>(iterations) * min_time_ns * 1.2 / elapsed : static_cast<double>(iterations) * 10;
+        iterations = std::max(iterations + 1, std::min(iterations * 100, static_cast<uint64_t>(target)));
+    }
+}
+
+/**
+ * @brief Returns a random number with exactly digits decimal digits, positive or negative
+ */
+
+string random_digits(std::mt19937_64 &engine, size_t digits, bool negative = false)
+{
+    size_t first = negative ? 1 : 0;
+    string text(first + digits, '-');
+    text[first] = static_cast<char>('1' + engine() % 9);
+    for (size_t i = first + 1; i < text.size(); ++i)
+        text[i] = static_cast<char>('0' + engine() % 10);
+    return text;
+}
+
+/**
+ * @brief Collects the results of the selected cases and writes them as JSON
+ */
+
+class bench_suite
+{
+public:
+    explicit bench_suite(const bench_options &suite_options) : options(suite_options) {}
+
+    /**
+     * @brief Times one case unless it is filtered out or its operands are too large for its complexity, and returns its result or nullptr if it was skipped
+     *
+     * @param name The name of the operation in the report
+     * @param digits The size of the first operand in decimal digits
+     * @param operand_digits The size of the second operand in decimal digits, 0 if there is none
+     * @param quadratic Whether the operation takes quadratic time, so it is capped at --max-quadratic-digits
+     * @param body The operation to time
+     */
+
+    template <typename Body>
+    const bench_result *run(const string &name, size_t digits, size_t operand_digits, bool quadratic, Body &&body)
+    {
+        if (!options.filter.empty() && name.find(options.filter) == string::npos)
+            return nullptr;
+        if (quadratic && std::max(digits, operand_digits) > options.max_quadratic_digits)
+            return nullptr;
+        bench_result result = measure(options, body);
+        result.name = name;
+        result.digits = digits;
+        result.operand_digits = operand_digits;
+        results.push_back(result);
+        cerr << name << " " << digits;
+        if (operand_digits != 0)
+            cerr << "/" << operand_digits;
+        cerr << " : " << result.ns_per_op << " ns/op" << endl;
+        return &results.back();
+    }
+
+    void write_json(ostream &out) const
+    {
+        out << "{\n  \"context\": {\"max_digits\": " << options.max_digits << ", \"max_quadratic_digits\": " << options.max_quadratic_digits
+            << ", \"min_time_ms\": " << options.min_time_ms << ", \"threads\": " << BigInt::getthreads() << "},\n  \"benchmarks\": [";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const bench_result &result = results[i];
+            out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << result.name << "\", \"digits\": " << result.digits << ", \"operand_digits\": " << result.operand_digits
+                << ", \"iterations\": " << result.iterations << ", \"ns_per_op\": " << result.ns_per_op << ", \"allocs_per_op\": " << result.allocs_per_op
+                << ", \"bytes_per_op\": " << result.bytes_per_op << ", \"peak_bytes\": " << result.peak_bytes << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+private:
+    const bench_options &options;
+    vector<bench_result> results;
+};
+
+// ---------------------------------------- cases ----------------------------------------
+
+/**
+ * @brief Times every constructor, conversion and unary operation on a number of the given size
+ */
+
+void bench_unary(bench_suite &suite, std::mt19937_64 &engine, size_t digits)
+{
+    const string text = random_digits(engine, digits);
+    const BigInt a(text);
+    const vector<std::byte> bytes = a.serialize();
+
+    suite.run("BigInt(string)", digits, 0, false, [&]
+              { BigInt x(text); keep(x); });
+    for (unsigned base : {2U, 8U, 16U, 36U})
+    {
+        const string other = a.to_string(base);
+        suite.run("BigInt(string, " + std::to_string(base) + ")", digits, 0, false, [&]
+                  { BigInt x(other, base); keep(x); });
+    }
+    suite.run("BigInt(const BigInt &)", digits, 0, false, [&]
+              { BigInt x(a); keep(x); });
+    BigInt held = a, spare;
+    // each move is undone in the same call, so every call finds a value to move
+    suite.run("BigInt(BigInt &&)", digits, 0, false, [&]
+              { BigInt x(std::move(held)); keep(x); held = std::move(x); });
+    suite.run("operator=(const BigInt &)", digits, 0, false, [&]
+              { spare = a; keep(spare); });
+    suite.run("operator=(BigInt &&)", digits, 0, false, [&]
+              { spare = std::move(held); keep(spare); std::swap(held, spare); });
+    suite.run("BigInt(BigIntView)", digits, 0, false, [&]
+              { BigInt x{BigIntView(a)}; keep(x); });
+    suite.run("setnumber", digits, 0, false, [&]
+              { BigInt x; x.setnumber(text); keep(x); });
+    suite.run("operator>>", digits, 0, false, [&]
+              { istringstream in(text); BigInt x; in >> x; keep(x); });
+    suite.run("deserialize", digits, 0, false, [&]
+              { BigInt x = BigInt::deserialize(bytes); keep(x); });
+    const uint64_t bits = 4 * a.to_string(16).size();
+    suite.run("random_bits", digits, 0, false, [&]
+              { BigInt x = BigInt::random_bits(bits, engine); keep(x); });
+    suite.run("random_below", digits, 0, false, [&]
+              { BigInt x = BigInt::random_below(a, engine); keep(x); });
+
+    suite.run("getnumber", digits, 0, false, [&]
+              { string s = a.getnumber(); keep(s); });
+    for (unsigned base : {2U, 8U, 16U, 36U})
+        suite.run("to_string(" + std::to_string(base) + ")", digits, 0, false, [&]
+                  { string s = a.to_string(base); keep(s); });
+    suite.run("operator<<", digits, 0, false, [&]
+              { ostringstream out; out << a; keep(out); });
+    suite.run("getsize", digits, 0, false, [&]
+              { size_t size = a.getsize(); keep(size); });
+    suite.run("to_double", digits, 0, false, [&]
+              { double value = a.to_double(); keep(value); });
+    suite.run("to_long_double", digits, 0, false, [&]
+              { long double value = a.to_long_double(); keep(value); });
+    suite.run("frexp", digits, 0, false, [&]
+              { int64_t exponent = 0; double mantissa = a.frexp(exponent); keep(mantissa); keep(exponent); });
+    if (a.fits_in<int64_t>()) // the word conversions throw beyond one limb
+    {
+        suite.run("to_int64", digits, 0, false, [&]
+                  { int64_t value = a.to_int64(); keep(value); });
+        suite.run("to_uint64", digits, 0, false, [&]
+                  { uint64_t value = a.to_uint64(); keep(value); });
+    }
+    suite.run("fits_in<int64_t>", digits, 0, false, [&]
+              { bool fits = a.fits_in<int64_t>(); keep(fits); });
+    suite.run("hash", digits, 0, false, [&]
+              { size_t value = a.hash(); keep(value); });
+    suite.run("serialize", digits, 0, false, [&]
+              { vector<std::byte> out = a.serialize(); keep(out); });
+
+    suite.run("operator-()", digits, 0, false, [&]
+              { BigInt x = -a; keep(x); });
+    suite.run("abs", digits, 0, false, [&]
+              { BigInt x = a.abs(); keep(x); });
+    BigInt counter = a;
+    suite.run("operator++", digits, 0, false, [&]
+              { ++counter; keep(counter); });
+    suite.run("operator--", digits, 0, false, [&]
+              { --counter; keep(counter); });
+    suite.run("operator++(int)", digits, 0, false, [&]
+              { BigInt old = counter++; keep(old); });
+    suite.run("operator--(int)", digits, 0, false, [&]
+              { BigInt old = counter--; keep(old); });
+    suite.run("operator*(x, x)", digits, 0, false, [&]
+              { BigInt x = a * a; keep(x); });
+}
+
+/**
+ * @brief Times every binary operator and comparison on operands of digits and operand_digits digits
+ */
+
+void bench_binary(bench_suite &suite, std::mt19937_64 &engine, size_t digits, size_t operand_digits)
+{
+    const BigInt a(random_digits(engine, digits));
+    const BigInt b(random_digits(engine, operand_digits, true));
+    const BigInt c = a; // equal to a, so the comparisons read every limb
+    const bool quadratic = operand_digits > 19; // a divisor of one limb is divided out in linear time
+
+    suite.run("operator+", digits, operand_digits, false, [&]
+              { BigInt x = a + b; keep(x); });
+    suite.run("operator-", digits, operand_digits, false, [&]
+              { BigInt x = a - b; keep(x); });
+    suite.run("operator*", digits, operand_digits, false, [&]
+              { BigInt x = a * b; keep(x); });
+    suite.run("operator/", digits, operand_digits, quadratic, [&]
+              { BigInt x = a / b; keep(x); });
+    suite.run("operator%", digits, operand_digits, quadratic, [&]
+              { BigInt x = a % b; keep(x); });
+
+    BigInt accumulator = a;
+    suite.run("operator+=", digits, operand_digits, false, [&]
+              { accumulator += b; keep(accumulator); });
+    suite.run("operator-=", digits, operand_digits, false, [&]
+              { accumulator -= b; keep(accumulator); });
+    suite.run("operator*=", digits, operand_digits, false, [&]
+              { BigInt x = a; x *= b; keep(x); });
+    suite.run("operator/=", digits, operand_digits, quadratic, [&]
+              { BigInt x = a; x /= b; keep(x); });
+    suite.run("operator%=", digits, operand_digits, quadratic, [&]
+              { BigInt x = a; x %= b; keep(x); });
+
+    suite.run("operator==", digits, operand_digits, false, [&]
+              { bool equal = (a == c); keep(equal); });
+    suite.run("operator!=", digits, operand_digits, false, [&]
+              { bool different = (a != c); keep(different); });
+    suite.run("operator<", digits, operand_digits, false, [&]
+              { bool less = (a < c); keep(less); });
+    suite.run("operator<=", digits, operand_digits, false, [&]
+              { bool less_equal = (a <= c); keep(less_equal); });
+    suite.run("operator>", digits, operand_digits, false, [&]
+              { bool greater = (a > c); keep(greater); });
+    suite.run("operator>=", digits, operand_digits, false, [&]
+              { bool greater_equal = (a >= c); keep(greater_equal); });
+    suite.run("operator<=>", digits, operand_digits, false, [&]
+              { std::strong_ordering order = (a <=> c); keep(order); });
+
+    suite.run("gcd", digits, operand_digits, quadratic, [&]
+              { BigInt x = BigInt::gcd(a, b); keep(x); });
+}
+
+/**
+ * @brief An input stream buffer over a string that is not copied, so only the parser's own memory is live while it reads
+ */
+
+class text_buffer : public std::streambuf
+{
+public:
+    explicit text_buffer(const string &text)
+    {
+        char *begin = const_cast<char *>(text.data()); // only read, streambuf has no pointers to const
+        setg(begin, begin, begin + text.size());
+    }
+};
+
+/**
+ * @brief Times reading a number of the given size with the operator `>>` and from_fd(), returns false and reports the case if either has as many bytes live as the text it reads
+ */
+
+bool bench_parse_memory(bench_suite &suite, std::mt19937_64 &engine, size_t digits)
+{
+    const string text = random_digits(engine, digits);
+    bool within = true;
+    auto check = [&](const bench_result *result)
+    {
+        if (result == nullptr || result->peak_bytes < text.size())
+            return;
+        cerr << "Error: " << result->name << " had " << result->peak_bytes << " bytes live at once for " << text.size() << " digits" << endl;
+        within = false;
+    };
+
+    check(suite.run("operator>> (peak memory)", digits, 0, false, [&]
+                    { text_buffer buffer(text); istream in(&buffer); BigInt x; in >> x; keep(x); }));
+#if defined(BIGINT_HAS_FD_INPUT)
+    std::FILE *file = std::tmpfile();
+    if (file == nullptr || std::fwrite(text.data(), 1, text.size(), file) != text.size() || std::fflush(file) != 0)
+    {
+        cerr << "Error: could not write a temporary file for from_fd" << endl;
+        return false;
+    }
+    check(suite.run("from_fd (peak memory)", digits, 0, false, [&]
+                    { ::lseek(fileno(file), 0, SEEK_SET); BigInt x = BigInt::from_fd(fileno(file)); keep(x); }));
+    std::fclose(file);
+#endif
+    return within;
+}
+
+/**
+ * @brief Reads the command line, returns false and prints the usage on an unknown or incomplete option
+ */
+
+bool parse_options(int argc, char **argv, bench_options &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        string option = argv[i];
+        if (i + 1 >= argc)
+            return false;
+        string value = argv[++i];
+        try
+        {
+            if (option == "--max-digits")
+                options.max_digits = std::min<size_t>(std::stoull(value), 10000000);
+            else if (option == "--max-quadratic-digits")
+                options.max_quadratic_digits = std::stoull(value);
+            else if (option == "--min-time-ms")
+                options.min_time_ms = std::stod(value);
+            else if (option == "--filter")
+                options.filter = value;
+            else if (option == "--output")
+                options.output = value;
+            else
+                return false;
+        }
+        catch (const std::exception &)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    bench_options options;
+    if (!parse_options(argc, argv, options))
+    {
+        cerr << "Usage: " << argv[0] << " [--max-digits N] [--max-quadratic-digits N] [--min-time-ms T] [--filter TEXT] [--output FILE]" << endl;
+        return 1;
+    }
+
+    bench_suite suite(options);
+    std::mt19937_64 engine(20241);
+
+    suite.run("BigInt()", 0, 0, false, []
+              { BigInt x; keep(x); });
+    suite.run("BigInt(int64_t)", 19, 0, false, []
+              { BigInt x(-9223372036854775807LL); keep(x); });
+
+    for (size_t digits = 1; digits <= options.max_digits; digits *= 10)
+    {
+        bench_unary(suite, engine, digits);
+        bench_binary(suite, engine, digits, digits); // balanced operands
+        if (digits >= 100)
+            bench_binary(suite, engine, digits, digits / 2); // long division and products of unequal halves
+        if (digits > 10)
+            bench_binary(suite, engine, digits, 10); // huge op small, a single limb
+    }
+    bool within_memory = bench_parse_memory(suite, engine, 1000000);
+
+    if (options.output.empty())
+    {
+        suite.write_json(cout);
+        return within_memory ? 0 : 1;
+    }
+    ofstream out(options.output);
+    suite.write_json(out);
+    if (!out)
+    {
+        cerr << "Error: could not write " << options.output << endl;
+        return 1;
+    }
+    return within_memory ? 0 : 1;
+}
@@ -1,903 +1,7277 @@
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <stdexcept>
+#include <compare>
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <span>
+#include <bit>
+#include <cstring>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <cerrno>
+#include <random>
+#include <system_error>
+#include <chrono>
+#include <future>
+#include <stop_token>
+
+#if __has_include(<unistd.h>)
+#define BIGINT_HAS_FD_INPUT 1
+#include <unistd.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BIGINT_NOINLINE __attribute__((noinline)) // keeps rare slow paths out of the inlined fast paths
+#else
+#define BIGINT_NOINLINE
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(BIGINT_PORTABLE_KERNELS)
+#define BIGINT_X86_KERNELS 1
+#include <immintrin.h>
+#endif
 
 /**
- * @brief A class for arbitrary-precision integer
+ * @brief The operations counted by the instrumentation (see BigInt::getstats())
+ * add and subtract cover the operators +, +=, ++ and -, -=, --, parse covers the constructors and setnumber() that read digits, print covers getnumber(), to_string() and the operator <<
  */
 
-class BigInt
+enum class BigIntOp : unsigned char
 {
+    add,
+    subtract,
+    multiply,
+    square,
+    divide,
+    modulo,
+    divexact,
+    gcd,
+    parse,
+    print
+};
 
-public:
-    /**
-     * @brief The Default constructor which Construct a new BigInt object and initialize it to zero
-     */
+/**
+ * @brief The algorithm that handled an operation, as chosen at the top level of the call
+ * basecase is the schoolbook method (and Lehmer's method for gcd), single_limb the divrem_1 and divexact_1 kernels for one-limb divisors, karatsuba and unbalanced the two subquadratic multiplications (karatsuba also the blockwise exact division built on them), and divide_and_conquer the subquadratic radix conversions
+ */
 
-    BigInt();
+enum class BigIntTier : unsigned char
+{
+    none,
+    basecase,
+    single_limb,
+    karatsuba,
+    unbalanced,
+    divide_and_conquer
+};
 
-    /**
-     * @brief The constructor that takes a signed 64-bit integer and Construct a new BigInt object
-     *
-     * @param int_number The signed 64-bit integer
-     */
+/**
+ * @brief A snapshot of the counters of the instrumentation, returned by BigInt::getstats()
+ * Every operation is counted once in the bucket of its size, the number of limbs of its largest operand: bucket 0 holds zero, bucket k the sizes from 2^(k-1) to 2^k - 1 limbs and the last bucket everything above
+ * Operations that run inside another counted operation (the products of a radix conversion, for example) are part of the outer one and are not counted again
+ * The counters only move when BIGINT_INSTRUMENTATION is defined before including this header, otherwise the snapshot is always zero and the instrumentation compiles to nothing
+ */
 
-    BigInt(const int64_t int_number);
+struct BigIntStats
+{
+    static constexpr bool enabled =
+#if defined(BIGINT_INSTRUMENTATION)
+        true;
+#else
+        false;
+#endif
+    static constexpr size_t op_count = 10;
+    static constexpr size_t tier_count = 6;
+    static constexpr size_t bucket_count = 24;
+
+    uint64_t calls[op_count][bucket_count] = {}; // calls per operation and size bucket
+    uint64_t tiers[op_count][tier_count] = {};   // calls per operation and algorithm tier
+    uint64_t nanoseconds[op_count] = {};         // wall-clock time spent per operation
+    uint64_t bytes[op_count] = {};               // bytes of magnitudes allocated per operation
+    uint64_t bytes_allocated = 0;                // bytes of magnitudes allocated in total, inside counted operations or not
+    uint64_t allocations = 0;                    // number of magnitude allocations in total
 
     /**
-     * @brief The constructor that takes a string of digits and construct a new BigInt object
-     * Since a string input may have a bad format with leading zeros and spaces or contain invalid digits
-     * Then before finalizing the construction, the input need to be trimmed and validated to ensure it represents a valid and well-formatted input for the rest of process
-     *
-     * @param str_number The string representing the integer
+     * @brief Returns the size bucket of an operand of the given number of limbs
      */
 
-    BigInt(const std::string &str_number);
+    static size_t bucket(size_t limbs)
+    {
+        return std::min<size_t>(static_cast<size_t>(std::bit_width(limbs)), bucket_count - 1);
+    }
 
     /**
-     * @brief The member function which returns the sign of a BigInt object
-     * Used to access the 'sign' which is private member of the BigInt class, and read the sign of an object
-     *
-     * @return A character representing the sign of a BigInt object ('+' or '-')
+     * @brief Returns the number of calls of an operation over all size buckets
      */
 
-    char getsign() const;
+    uint64_t total_calls(BigIntOp op) const
+    {
+        uint64_t total = 0;
+        for (uint64_t count : calls[static_cast<size_t>(op)])
+            total += count;
+        return total;
+    }
 
     /**
-     * @brief The member function that receives and sets the sign of a new BigInt object
-     * Used to set the sign for a newly created BigInt object resulting from operations like *, + , - , / and %
-     *
-     * @param ch A character representing the new sign ('+' or '-')
+     * @brief Returns the number of calls of an operation handled by the given algorithm tier
      */
 
-    void setsign(char ch);
+    uint64_t tier_calls(BigIntOp op, BigIntTier tier) const
+    {
+        return tiers[static_cast<size_t>(op)][static_cast<size_t>(tier)];
+    }
 
-    /**
-     * @brief The member function that returns the numerical part of a BigInt object
-     * Used to access the `number` which is a private member of the BigInt class, and read the numerical value without the sign
-     *
-     * @return A string representing the numerical part of a BigInt object
-     */
+    static const char *name(BigIntOp op)
+    {
+        static const char *const names[op_count] = {"add", "subtract", "multiply", "square", "divide", "modulo", "divexact", "gcd", "parse", "print"};
+        return names[static_cast<size_t>(op)];
+    }
 
-    std::string getnumber() const;
+    static const char *name(BigIntTier tier)
+    {
+        static const char *const names[tier_count] = {"none", "basecase", "single_limb", "karatsuba", "unbalanced", "divide_and_conquer"};
+        return names[static_cast<size_t>(tier)];
+    }
+};
 
-    /**
-     * @brief The member function that receives and sets the numerical part of a new BigInt object
-     * Used to set the numerical part for a newly created BigInt object resulting from operations like *, +, - , / and %
-     * Since leading zeros may be added during operations to align numbers, this function remove leading zeros before setting the `number`, ensuring a valid input
-     *
-     * @param str A string representing the new numerical value
-     */
+/**
+ * @brief One counted operation, passed to the hook registered with BigInt::setstatshook() when it finishes
+ */
 
-    void setnumber(const std::string &str);
+struct BigIntEvent
+{
+    BigIntOp op;
+    BigIntTier tier;
+    size_t limbs;         // the number of limbs of the largest operand
+    uint64_t nanoseconds; // the wall-clock time of the operation
+    uint64_t bytes;       // the bytes of magnitudes it allocated
+};
 
-    /**
-     * @brief The member function that returns number of digits in the numerical part of a BigInt object
-     *
-     * @return size_t The number of digits in the numerical part of a BigInt object
-     */
+/**
+ * @brief Low-level kernels that work on the magnitude of a BigInt object
+ * A magnitude is stored as an array of 64-bit limbs in little-endian order (limb 0 is the least significant one)
+ * Every kernel has a portable version that is always available, and on x86-64 the hand-tuned ADX/BMI2, AVX2 and AVX-512 versions are chosen at runtime depending on the CPU
+ * Defining BIGINT_PORTABLE_KERNELS before including this header disables the hand-tuned versions
+ * The destination of add_n, sub_n, mul_1, addmul_1 and submul_1 may be exactly the same array as a source but must not partially overlap it
+ */
 
-    size_t getsize() const;
+namespace bigint_detail
+{
+    using limb = uint64_t;
+
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 double_limb; // __extension__ keeps -Wpedantic quiet about the GCC/Clang 128-bit type
+#endif
 
     /**
-     * @brief The member function that returns the absolute value of a BigInt object
-     *
-     * @return BigInt the absolute value of the current BigInt (*this)
+     * @brief Multiplies two limbs and returns the low limb of the 128-bit product, the high limb is written to hi
      */
 
-    BigInt abs() const;
+    inline limb mul_wide(limb a, limb b, limb &hi)
+    {
+#if defined(__SIZEOF_INT128__)
+        double_limb product = static_cast<double_limb>(a) * b;
+        hi = static_cast<limb>(product >> 64);
+        return static_cast<limb>(product);
+#else
+        limb a_low = a & 0xffffffffULL, a_high = a >> 32;
+        limb b_low = b & 0xffffffffULL, b_high = b >> 32;
+        limb low_low = a_low * b_low, low_high = a_low * b_high, high_low = a_high * b_low, high_high = a_high * b_high;
+        limb middle = (low_low >> 32) + (low_high & 0xffffffffULL) + (high_low & 0xffffffffULL);
+        hi = high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+        return (middle << 32) | (low_low & 0xffffffffULL);
+#endif
+    }
 
     /**
-     * @brief Overloads the addition operator (+) for BigInt class
-     * Performs addition between the current BigInt object (*this) and  operand
-     * To align the numbers, leading zeros are added to the shorter number. The process then split into different scenarios based on the signs and sizes of the objects
-     * The addition is performed digit by digit, similar to the traditional school method
-     *
-     * @param operand The BigInt object to be added to *this
-     * @return BigInt a new BigInt object representing the sum of the two BigInt objects
+     * @brief Divides the two-limb number (high, low) by d and returns the quotient, the remainder is written to rem
+     * The quotient must fit in one limb, which means high < d
      */
 
-    BigInt operator+(const BigInt &operand) const;
+    inline limb div_wide(limb high, limb low, limb d, limb &rem)
+    {
+#if defined(__SIZEOF_INT128__)
+        double_limb numerator = (static_cast<double_limb>(high) << 64) | low;
+        rem = static_cast<limb>(numerator % d);
+        return static_cast<limb>(numerator / d);
+#else
+        // the two-digit long division of Hacker's Delight (divlu) with 32-bit digits
+        int shift = 0;
+        while ((d & (1ULL << 63)) == 0)
+        {
+            d <<= 1;
+            ++shift;
+        }
+        if (shift != 0)
+        {
+            high = (high << shift) | (low >> (64 - shift));
+            low <<= shift;
+        }
+        limb d_high = d >> 32, d_low = d & 0xffffffffULL;
+        limb low_high = low >> 32, low_low = low & 0xffffffffULL;
+        limb q1 = high / d_high, r = high - q1 * d_high;
+        while (q1 >> 32 || q1 * d_low > ((r << 32) | low_high))
+        {
+            --q1;
+            r += d_high;
+            if (r >> 32)
+                break;
+        }
+        limb middle = (high << 32) + low_high - q1 * d;
+        limb q0 = middle / d_high;
+        r = middle - q0 * d_high;
+        while (q0 >> 32 || q0 * d_low > ((r << 32) | low_low))
+        {
+            --q0;
+            r += d_high;
+            if (r >> 32)
+                break;
+        }
+        rem = ((middle << 32) + low_low - q0 * d) >> shift;
+        return (q1 << 32) | q0;
+#endif
+    }
 
     /**
-     * @brief Overloads the compound addition operator (+=) for BigInt class
-     * Uses the logic of the overloaded operator `+` and Performs addition between the current BigInt object (*this) and operand
-     * This process add operand to *this and update the value of *this
-     *
-     * @param operand The BigInt object to be added to (*this)
-     * @return BigInt& A reference to the updated BigInt object (*this)
+     * @brief Returns the number of leading zero bits of a non-zero limb
      */
 
-    BigInt &operator+=(const BigInt &operand);
+    inline int count_leading_zeros(limb x)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(x);
+#else
+        int count = 0;
+        while ((x & (1ULL << 63)) == 0)
+        {
+            x <<= 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    // ---------------------------------------- portable kernels ----------------------------------------
 
     /**
-     * @brief Overloads the subtraction operator (-) for BigInt class
-     * Performs subtraction between the current BigInt object (*this) and operand
-     * This operation takes advantage of the overloaded addition '+' and unary negation operators.It negates the operand and then adding it to *this
-     *
-     * @param operand The BigInt object to subtract from *this
-     * @return BigInt a new BigInt object representing the subtraction of the two BigInt objects
+     * @brief Adds the n-limb arrays ap and bp and the incoming carry (0 or 1), writes the n-limb sum to rp and returns the carry out (0 or 1)
      */
 
-    BigInt operator-(const BigInt &operand) const;
+    limb add_nc_portable(limb *rp, const limb *ap, const limb *bp, size_t n, limb carry)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb a = ap[i];
+            limb sum = a + bp[i];
+            limb carry_out = sum < a;
+            limb result = sum + carry;
+            carry_out |= result < sum;
+            rp[i] = result;
+            carry = carry_out;
+        }
+        return carry;
+    }
+
+    limb add_n_portable(limb *rp, const limb *ap, const limb *bp, size_t n)
+    {
+        return add_nc_portable(rp, ap, bp, n, 0);
+    }
 
     /**
-     * @brief Overloads the compound subtraction (-=) operator for BigInt class
-     * Uses the logic of the overloaded operator  `-` and Performs subtraction between the current BigInt object (*this) and operand
-     * this process subtract operand from *this and update the value of *this
-     *
-     * @param operand The BigInt object to subtract from *this
-     * @return BigInt& A reference to the updated BigInt object (*this)
+     * @brief Subtracts the n-limb array bp and the incoming borrow (0 or 1) from ap, writes the n-limb difference to rp and returns the borrow out (0 or 1)
      */
 
-    BigInt &operator-=(const BigInt &operand);
+    limb sub_nc_portable(limb *rp, const limb *ap, const limb *bp, size_t n, limb borrow)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb a = ap[i];
+            limb diff = a - bp[i];
+            limb borrow_out = a < bp[i];
+            limb result = diff - borrow;
+            borrow_out |= diff < borrow;
+            rp[i] = result;
+            borrow = borrow_out;
+        }
+        return borrow;
+    }
+
+    limb sub_n_portable(limb *rp, const limb *ap, const limb *bp, size_t n)
+    {
+        return sub_nc_portable(rp, ap, bp, n, 0);
+    }
 
     /**
-     * @brief Overloads the multiplication operator (*) for BigInt class
-     * Performs multiplication between the current BigInt object (*this) and the operand
-     * The multiplication is done digit-by-digit, similar to traditional school multiplication
-     * It also takes advantage of the overloaded addition `+` operator to sum the results of partial multiplications and compute the final result
-     *
-     * @param operand The BigInt object to multiply with *this
-     * @return BigInt a new BigInt object representing the multiplication of the two BigInt objects
+     * @brief Multiplies the n-limb array ap by the limb b, writes the low n limbs of the product to rp and returns the high limb
      */
 
-    BigInt operator*(const BigInt &operand) const;
+    limb mul_1_portable(limb *rp, const limb *ap, size_t n, limb b)
+    {
+        limb carry = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb hi;
+            limb lo = mul_wide(ap[i], b, hi);
+            lo += carry;
+            hi += lo < carry;
+            rp[i] = lo;
+            carry = hi;
+        }
+        return carry;
+    }
 
     /**
-     * @brief Overloads the compound multiplication (*=) operator for BigInt class
-     * Uses the logic of the overloaded operator `*` to perform multiplication between the current BigInt object (*this) and operand
-     * This process multiplies the operand with (*this) and updates the value of (*this)
-     *
-     * @param operand The BigInt object to multiply with *this
-     * @return BigInt& A reference to the updated BigInt object (*this)
+     * @brief Adds the product of the n-limb array ap and the limb b to the n-limb array rp and returns the limb carried out
      */
 
-    BigInt &operator*=(const BigInt &operand);
+    limb addmul_1_portable(limb *rp, const limb *ap, size_t n, limb b)
+    {
+        limb carry = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb hi;
+            limb lo = mul_wide(ap[i], b, hi);
+            lo += carry;
+            hi += lo < carry;
+            limb result = rp[i] + lo;
+            hi += result < lo;
+            rp[i] = result;
+            carry = hi;
+        }
+        return carry;
+    }
 
     /**
-     * @brief Overloads the unary negation operator (-) for BigInt class
-     * Changes the sign of the BigInt object from '+' to '-' and vice versa and returns a new BigInt object with the opposite sign
-     *
-     * @return BigInt a new BigInt object with the opposite sign
+     * @brief Subtracts the product of the n-limb array ap and the limb b from the n-limb array rp and returns the limb borrowed out
      */
 
-    BigInt operator-() const;
+    limb submul_1_portable(limb *rp, const limb *ap, size_t n, limb b)
+    {
+        limb borrow = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb hi;
+            limb lo = mul_wide(ap[i], b, hi);
+            lo += borrow;
+            hi += lo < borrow;
+            limb r = rp[i];
+            rp[i] = r - lo;
+            hi += r < lo;
+            borrow = hi;
+        }
+        return borrow;
+    }
 
-    /**
-     * @brief Overloads the division operator (/) for BigInt class
-     * Performs division of the current BigInt object (*this) as the dividend and the operand as the divisor
-     * Since applying division directly to strings is complicated and prone to errors, the function use the logic of overloaded comparison operators to split the operation into different possible scenarios
-     * For the scenario where the dividend > divisor, we take advantage of the overloaded operators (`*`, `+`, `-=`) to iteratively calculate the remainder and quotient
-     *
-     * @param operand The BigInt object as the divisor
-     * @return BigInt A BigInt representing the quotient of the division
-     */
+#if defined(BIGINT_X86_KERNELS)
 
-    BigInt operator/(const BigInt &operand) const;
+    // ---------------------------------------- x86-64 ADX/BMI2 kernels ----------------------------------------
+
+    __attribute__((target("adx,bmi2"))) limb add_n_adx(limb *rp, const limb *ap, const limb *bp, size_t n)
+    {
+        unsigned char carry = 0;
+        unsigned long long r0, r1, r2, r3;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) // unrolled by four so the carry flag stays in a register chain
+        {
+            carry = _addcarryx_u64(carry, ap[i], bp[i], &r0);
+            carry = _addcarryx_u64(carry, ap[i + 1], bp[i + 1], &r1);
+            carry = _addcarryx_u64(carry, ap[i + 2], bp[i + 2], &r2);
+            carry = _addcarryx_u64(carry, ap[i + 3], bp[i + 3], &r3);
+            rp[i] = r0;
+            rp[i + 1] = r1;
+            rp[i + 2] = r2;
+            rp[i + 3] = r3;
+        }
+        for (; i < n; ++i)
+        {
+            carry = _addcarryx_u64(carry, ap[i], bp[i], &r0);
+            rp[i] = r0;
+        }
+        return carry;
+    }
+
+    __attribute__((target("adx,bmi2"))) limb sub_n_adx(limb *rp, const limb *ap, const limb *bp, size_t n)
+    {
+        unsigned char borrow = 0;
+        unsigned long long r0, r1, r2, r3;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            borrow = _subborrow_u64(borrow, ap[i], bp[i], &r0);
+            borrow = _subborrow_u64(borrow, ap[i + 1], bp[i + 1], &r1);
+            borrow = _subborrow_u64(borrow, ap[i + 2], bp[i + 2], &r2);
+            borrow = _subborrow_u64(borrow, ap[i + 3], bp[i + 3], &r3);
+            rp[i] = r0;
+            rp[i + 1] = r1;
+            rp[i + 2] = r2;
+            rp[i + 3] = r3;
+        }
+        for (; i < n; ++i)
+        {
+            borrow = _subborrow_u64(borrow, ap[i], bp[i], &r0);
+            rp[i] = r0;
+        }
+        return borrow;
+    }
+
+    // addmul_1 and submul_1 keep two independent carry chains in the CF and OF flags (adcx/adox), which cannot be expressed reliably with intrinsics
+    // the loop index runs from -n up to zero with lea and jrcxz so neither flag is disturbed by the loop control
+
+    __attribute__((target("adx,bmi2"))) limb addmul_1_adx(limb *rp, const limb *ap, size_t n, limb b)
+    {
+        if (n == 0)
+            return 0;
+        limb carry;
+        const limb *a_end = ap + n;
+        limb *r_end = rp + n;
+        long long index = -static_cast<long long>(n);
+        __asm__ volatile(
+            "xorl %%r8d, %%r8d\n\t" // clears CF, OF and the previous high limb
+            "1:\n\t"
+            "mulx (%[a_end],%%rcx,8), %%r10, %%r9\n\t" // r9:r10 = a[i] * b
+            "adcx %%r8, %%r10\n\t"                      // low += previous high + CF
+            "adox (%[r_end],%%rcx,8), %%r10\n\t"        // low += r[i] + OF
+            "movq %%r10, (%[r_end],%%rcx,8)\n\t"
+            "movq %%r9, %%r8\n\t"
+            "leaq 1(%%rcx), %%rcx\n\t"
+            "jrcxz 2f\n\t"
+            "jmp 1b\n\t"
+            "2:\n\t"
+            "movl $0, %%r9d\n\t"
+            "adcx %%r9, %%r8\n\t"
+            "adox %%r9, %%r8\n\t"
+            "movq %%r8, %[carry]\n\t"
+            : [carry] "=r"(carry), "+c"(index)
+            : [a_end] "r"(a_end), [r_end] "r"(r_end), "d"(b)
+            : "r8", "r9", "r10", "cc", "memory");
+        return carry;
+    }
+
+    __attribute__((target("adx,bmi2"))) limb submul_1_adx(limb *rp, const limb *ap, size_t n, limb b)
+    {
+        if (n == 0)
+            return 0;
+        limb borrow;
+        const limb *a_end = ap + n;
+        limb *r_end = rp + n;
+        long long index = -static_cast<long long>(n);
+        // r[i] - x is computed as r[i] + ~x + 1, so the CF chain starts at one and its final value is the inverted borrow
+        __asm__ volatile(
+            "xorl %%r8d, %%r8d\n\t"
+            "stc\n\t"
+            "1:\n\t"
+            "mulx (%[a_end],%%rcx,8), %%r10, %%r9\n\t" // r9:r10 = a[i] * b
+            "adox %%r8, %%r10\n\t"                      // low += previous high + OF
+            "notq %%r10\n\t"
+            "adcx (%[r_end],%%rcx,8), %%r10\n\t"        // r[i] + ~low + CF
+            "movq %%r10, (%[r_end],%%rcx,8)\n\t"
+            "movq %%r9, %%r8\n\t"
+            "leaq 1(%%rcx), %%rcx\n\t"
+            "jrcxz 2f\n\t"
+            "jmp 1b\n\t"
+            "2:\n\t"
+            "movl $0, %%r9d\n\t"
+            "adox %%r9, %%r8\n\t"         // high += OF
+            "movl $0, %%r10d\n\t"
+            "adcx %%r9, %%r10\n\t"        // r10 = CF
+            "xorq $1, %%r10\n\t"          // borrow of the subtraction chain
+            "addq %%r10, %%r8\n\t"
+            "movq %%r8, %[borrow]\n\t"
+            : [borrow] "=r"(borrow), "+c"(index)
+            : [a_end] "r"(a_end), [r_end] "r"(r_end), "d"(b)
+            : "r8", "r9", "r10", "cc", "memory");
+        return borrow;
+    }
+
+    // ---------------------------------------- x86-64 AVX2 and AVX-512 kernels ----------------------------------------
+
+    // The vector kernels add a whole block of limbs at once and resolve the carries with carry-lookahead on bit masks
+    // For each lane, generate = the lane overflowed and propagate = the lane is all ones (it overflows only if a carry comes in)
+    // The carries coming into the lanes are ((generate << 1 | carry_in) + propagate) ^ propagate and the block carries out through the bit above the last lane
+
+    __attribute__((target("avx2"))) limb add_n_avx2(limb *rp, const limb *ap, const limb *bp, size_t n)
+    {
+        const __m256i sign_bit = _mm256_set1_epi64x(static_cast<long long>(1ULL << 63));
+        const __m256i all_ones = _mm256_set1_epi64x(-1);
+        const __m256i lane_bits = _mm256_set_epi64x(8, 4, 2, 1);
+        unsigned carry = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ap + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bp + i));
+            __m256i sum = _mm256_add_epi64(a, b);
+            __m256i overflow = _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign_bit), _mm256_xor_si256(sum, sign_bit)); // unsigned sum < a
+            unsigned generate = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(overflow)));
+            unsigned propagate = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(sum, all_ones))));
+            unsigned lookahead = ((generate << 1) | carry) + propagate;
+            unsigned carries = (lookahead ^ propagate) & 0xf;
+            carry = lookahead >> 4;
+            __m256i carry_lanes = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(carries), lane_bits), lane_bits);
+            sum = _mm256_sub_epi64(sum, carry_lanes); // subtracting -1 adds the incoming carry
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(rp + i), sum);
+        }
+        return add_nc_portable(rp + i, ap + i, bp + i, n - i, carry);
+    }
+
+    __attribute__((target("avx2"))) limb sub_n_avx2(limb *rp, const limb *ap, const limb *bp, size_t n)
+    {
+        const __m256i sign_bit = _mm256_set1_epi64x(static_cast<long long>(1ULL << 63));
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i lane_bits = _mm256_set_epi64x(8, 4, 2, 1);
+        unsigned borrow = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ap + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bp + i));
+            __m256i diff = _mm256_sub_epi64(a, b);
+            __m256i underflow = _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign_bit), _mm256_xor_si256(a, sign_bit)); // unsigned a < b
+            unsigned generate = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(underflow)));
+            unsigned propagate = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(diff, zero))));
+            unsigned lookahead = ((generate << 1) | borrow) + propagate;
+            unsigned borrows = (lookahead ^ propagate) & 0xf;
+            borrow = lookahead >> 4;
+            __m256i borrow_lanes = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(borrows), lane_bits), lane_bits);
+            diff = _mm256_add_epi64(diff, borrow_lanes); // adding -1 takes the incoming borrow
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(rp + i), diff);
+        }
+        return sub_nc_portable(rp + i, ap + i, bp + i, n - i, borrow);
+    }
+
+    __attribute__((target("avx512f"))) limb add_n_avx512(limb *rp, const limb *ap, const limb *bp, size_t n)
+    {
+        const __m512i all_ones = _mm512_set1_epi64(-1);
+        const __m512i one = _mm512_set1_epi64(1);
+        unsigned carry = 0;
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m512i a = _mm512_loadu_si512(ap + i);
+            __m512i b = _mm512_loadu_si512(bp + i);
+            __m512i sum = _mm512_add_epi64(a, b);
+            unsigned generate = _mm512_cmplt_epu64_mask(sum, a);
+            unsigned propagate = _mm512_cmpeq_epu64_mask(sum, all_ones);
+            unsigned lookahead = ((generate << 1) | carry) + propagate;
+            __mmask8 carries = static_cast<__mmask8>(lookahead ^ propagate);
+            carry = lookahead >> 8;
+            sum = _mm512_mask_add_epi64(sum, carries, sum, one);
+            _mm512_storeu_si512(rp + i, sum);
+        }
+        return add_nc_portable(rp + i, ap + i, bp + i, n - i, carry);
+    }
+
+    __attribute__((target("avx512f"))) limb sub_n_avx512(limb *rp, const limb *ap, const limb *bp, size_t n)
+    {
+        const __m512i zero = _mm512_setzero_si512();
+        const __m512i one = _mm512_set1_epi64(1);
+        unsigned borrow = 0;
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m512i a = _mm512_loadu_si512(ap + i);
+            __m512i b = _mm512_loadu_si512(bp + i);
+            __m512i diff = _mm512_sub_epi64(a, b);
+            unsigned generate = _mm512_cmplt_epu64_mask(a, b);
+            unsigned propagate = _mm512_cmpeq_epu64_mask(diff, zero);
+            unsigned lookahead = ((generate << 1) | borrow) + propagate;
+            __mmask8 borrows = static_cast<__mmask8>(lookahead ^ propagate);
+            borrow = lookahead >> 8;
+            diff = _mm512_mask_sub_epi64(diff, borrows, diff, one);
+            _mm512_storeu_si512(rp + i, diff);
+        }
+        return sub_nc_portable(rp + i, ap + i, bp + i, n - i, borrow);
+    }
+
+#endif
+
+    // ---------------------------------------- runtime dispatch ----------------------------------------
 
     /**
-     * @brief Overloads the compound division operator (/=) for BigInt class
-     * Uses the logic of the overloaded operator `/`  to divide the current BigInt object (*this) by the operand as divisor
-     * Updates *this with the quotient and returns the updated *this
-     *
-     * @param operand The BigInt object as the divisor
-     * @return BigInt& A reference to the updated object (*this)
+     * @brief The table of kernels used by the BigInt class, with the name of the variant chosen for each kernel
      */
 
-    BigInt &operator/=(const BigInt &operand);
+    struct kernel_table
+    {
+        limb (*add_n)(limb *rp, const limb *ap, const limb *bp, size_t n);
+        limb (*sub_n)(limb *rp, const limb *ap, const limb *bp, size_t n);
+        limb (*mul_1)(limb *rp, const limb *ap, size_t n, limb b);
+        limb (*addmul_1)(limb *rp, const limb *ap, size_t n, limb b);
+        limb (*submul_1)(limb *rp, const limb *ap, size_t n, limb b);
+        const char *add_sub_variant;
+        const char *mul_variant;
+    };
 
     /**
-     * @brief Overloads the modulus operator (%) for BigInt class
-     * Uses the logic of the overloaded operator `/` to calculate the quotient, and then takes advantage of the overloaded operators `-` and `*` operators to compute the modulus based on the traditional formula
-     *
-     * @param operand The BigInt object as the divisor
-     * @return BigInt a new BigInt object representing the remainder of the division
+     * @brief Builds the kernel table for the CPU the program is running on
+     * The portable kernels are the fallback. For add_n and sub_n the vector versions beat the adc chain, so AVX-512 is preferred over AVX2 and AVX2 over ADX
+     * addmul_1 and submul_1 use the ADX/BMI2 versions, while mul_1 stays portable because the compiler's mul loop is already as fast as mulx for a single carry chain
      */
 
-    BigInt operator%(const BigInt &operand) const;
+    kernel_table select_kernels()
+    {
+        kernel_table table{add_n_portable, sub_n_portable, mul_1_portable, addmul_1_portable, submul_1_portable, "portable", "portable"};
+#if defined(BIGINT_X86_KERNELS)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("adx") && __builtin_cpu_supports("bmi2"))
+        {
+            table.add_n = add_n_adx;
+            table.sub_n = sub_n_adx;
+            table.addmul_1 = addmul_1_adx;
+            table.submul_1 = submul_1_adx;
+            table.add_sub_variant = "adx";
+            table.mul_variant = "adx";
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            table.add_n = add_n_avx2;
+            table.sub_n = sub_n_avx2;
+            table.add_sub_variant = "avx2";
+        }
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            table.add_n = add_n_avx512;
+            table.sub_n = sub_n_avx512;
+            table.add_sub_variant = "avx512";
+        }
+#endif
+        return table;
+    }
 
     /**
-     * @brief Overloads the compound modulus operator (%=) for BigInt class
-     * Uses the logic of the overloaded operator `%` to calculate the remainder of the division of the current BigInt object (*this) by the operand and return updated *this
-     *
-     * @param operand The BigInt object as the divisor
-     * @return BigInt&  A reference to the updated BigInt object (*this)
+     * @brief Returns the kernel table, which is selected once on first use
      */
 
-    BigInt &operator%=(const BigInt &operand);
+    const kernel_table &kernels()
+    {
+        static const kernel_table table = select_kernels();
+        return table;
+    }
 
+    // ---------------------------------------- instrumentation ----------------------------------------
+
+#if defined(BIGINT_INSTRUMENTATION)
     /**
-     * @brief Overloads the equality (==) operator for BigInt class
-     * Compare the current BigInt object (*this) and operand to determine whether they are equal or not
-     * First Compares the signs and sizes of both BigInt objects ,If the sizes and signs are equal, performs a digit-by-digit comparison of their numerical values
-     *
-     * @param operand The BigInt object to compare with (*this)
-     * @return true if the two BigInt objects are equal
-     * @return false if the two BigInt objects are not equal
+     * @brief The counters behind BigInt::getstats(), updated with relaxed atomic increments so that operations on different threads can be counted at the same time
      */
 
-    bool operator==(const BigInt &operand) const;
+    struct stats_registry
+    {
+        std::atomic<uint64_t> calls[BigIntStats::op_count][BigIntStats::bucket_count];
+        std::atomic<uint64_t> tiers[BigIntStats::op_count][BigIntStats::tier_count];
+        std::atomic<uint64_t> nanoseconds[BigIntStats::op_count];
+        std::atomic<uint64_t> bytes[BigIntStats::op_count];
+        std::atomic<uint64_t> bytes_allocated;
+        std::atomic<uint64_t> allocations;
+        std::function<void(const BigIntEvent &)> hook;
+    };
+
+    stats_registry &stats()
+    {
+        static stats_registry registry;
+        return registry;
+    }
 
     /**
-     * @brief Overloads the inequality operator (!=) for BigInt class
-     * uses the logic of the equality operator (`==`) and Compares the current BigInt object (*this) with the operand for inequality
-     *
-     * @param operand The BigInt object to compare with *this
-     * @return true if the two BigInt objects are not equal
-     * @return false if the two BigInt objects are equal
+     * @brief Times and counts one operation from its construction to its destruction, and calls the hook at the end
+     * Only the outermost scope of a thread is active, so the operations an operation is built of are not counted twice, and the tier and the allocations are credited to the outermost operation
      */
 
-    bool operator!=(const BigInt &operand) const;
+    class stat_scope
+    {
+    public:
+        stat_scope(BigIntOp scope_op, size_t scope_limbs, BigIntTier scope_tier = BigIntTier::none) : op(scope_op), limbs(scope_limbs), tier(scope_tier), active(current() == nullptr)
+        {
+            if (!active)
+                return;
+            current() = this;
+            start = std::chrono::steady_clock::now();
+        }
+
+        ~stat_scope()
+        {
+            if (!active)
+                return;
+            uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            current() = nullptr;
+
+            stats_registry &registry = stats();
+            size_t index = static_cast<size_t>(op);
+            registry.calls[index][BigIntStats::bucket(limbs)].fetch_add(1, std::memory_order_relaxed);
+            registry.tiers[index][static_cast<size_t>(tier)].fetch_add(1, std::memory_order_relaxed);
+            registry.nanoseconds[index].fetch_add(elapsed, std::memory_order_relaxed);
+            registry.bytes[index].fetch_add(bytes, std::memory_order_relaxed);
+
+            thread_local bool in_hook = false; // operations made by the hook itself are counted but do not call it again
+            if (registry.hook && !in_hook)
+            {
+                in_hook = true;
+                registry.hook(BigIntEvent{op, tier, limbs, elapsed, bytes});
+                in_hook = false;
+            }
+        }
+
+        stat_scope(const stat_scope &) = delete;
+        stat_scope &operator=(const stat_scope &) = delete;
+
+        /**
+         * @brief Sets the size of an operation whose size is only known at the end, like the number of limbs a parse produces
+         */
+
+        void set_limbs(size_t count) noexcept
+        {
+            limbs = count;
+        }
+
+        static stat_scope *&current()
+        {
+            thread_local stat_scope *scope = nullptr;
+            return scope;
+        }
+
+        BigIntOp op;
+        size_t limbs;
+        BigIntTier tier;
+        bool active;
+        uint64_t bytes = 0;
+        std::chrono::steady_clock::time_point start;
+    };
 
     /**
-     * @brief Overloads the greater-than operator (>) for BigInt class
-     * Compares the current BigInt object (*this) with the operand to determine whether *this is greater than the operand or not
-     * The comparison is split into different scenarios based on the signs of the objects
-     *
-     * @param operand The BigInt object to compare with *this
-     * @return true if (*this) is greater than the operand
-     * @return false if (*this) is not greater than the operand
+     * @brief Records the algorithm of the running operation, the first call wins so that the top-level choice is kept over the ones of the recursive calls
      */
 
-    bool operator>(const BigInt &operand) const;
+    inline void note_tier(BigIntTier tier)
+    {
+        stat_scope *scope = stat_scope::current();
+        if (scope != nullptr && scope->tier == BigIntTier::none)
+            scope->tier = tier;
+    }
 
+    inline void note_allocation(size_t bytes)
+    {
+        stats_registry &registry = stats();
+        registry.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+        registry.allocations.fetch_add(1, std::memory_order_relaxed);
+        if (stat_scope *scope = stat_scope::current())
+            scope->bytes += bytes;
+    }
+#else
     /**
-     * @brief Overloads the less-than operator (<) for BigInt class
-     * Uses the logic of the overloaded operator `>` to compare the current BigInt object (*this) with operand to determines whether (*this) is less than the operand or not
-     *
-     * @param operand The BigInt object to compare with *this
-     * @return true if (*this) is less than the operand
-     * @return false if (*this) is not less than the operand
+     * @brief Without BIGINT_INSTRUMENTATION the scope and the notes are empty inline functions, so the compiler removes them entirely
      */
 
-    bool operator<(const BigInt &operand) const;
+    class stat_scope
+    {
+    public:
+        stat_scope(BigIntOp, size_t, BigIntTier = BigIntTier::none) noexcept {}
+
+        void set_limbs(size_t) noexcept {}
+    };
+
+    inline void note_tier(BigIntTier) noexcept {}
+
+    inline void note_allocation(size_t) noexcept {}
+#endif
+
+    // ---------------------------------------- cancellation and progress ----------------------------------------
 
     /**
-     * @brief Overloads the greater-than-or-equal-to operator (>=) for BigInt class
-     * Uses the logic of the overloaded operators `>` and `==` to compare the current BigInt object (*this) with the operand to determines whether *this is greater than or equal to the operand or not
-     *
-     * @param operand The BigInt object to compare with *this
-     * @return true if (*this) is greater than or equal to the operand
-     * @return false if (*this) is not greater than or equal to the operand
+     * @brief The state of an asynchronous operation (see BigInt::async_mul()), visible to the algorithms through the thread that runs it
+     * The work is a range [begin, limit) of the interval [0, 1]: every step of an algorithm takes a fraction of the range of its parent, and done moves to the end of a step when it finishes
+     * A step never reaches past the end of its parent, so the progress stays monotonic even where the fractions are only estimates
      */
 
-    bool operator>=(const BigInt &operand) const;
+    struct task_control
+    {
+        std::stop_token stop;
+        std::function<void(double)> progress;
+        double begin = 0;
+        double limit = 1;
+        double done = 0;
+        double reported = 0;
+
+        /**
+         * @brief Calls the progress function when the work moved by at least 0.1% since the last call, or at the end
+         */
+
+        void report()
+        {
+            if (progress && (done >= reported + 0.001 || (done == 1 && reported < 1)))
+            {
+                reported = done;
+                progress(done);
+            }
+        }
+    };
+
+    inline task_control *&current_task()
+    {
+        thread_local task_control *task = nullptr;
+        return task;
+    }
 
     /**
-     * @brief Overloads the less-than-or-equal-to operator (<=) for BigInt class
-     * Uses the logic of the overloaded operators `<` and `==` to compare the current BigInt object (*this) with the given operand and determines whether (*this) is less than or equal to the operand or not
-     *
-     * @param operand The BigInt object to compare with (*this)
-     * @return true  if (*this) is less than or equal to the operand
-     * @return false if (*this) is not less than or equal to the operand
+     * @brief Throws std::system_error with std::errc::operation_canceled if the stop of the running asynchronous operation was requested
+     * Called at the chunk boundaries of the long algorithms, it is a thread-local read and a branch when no asynchronous operation runs
      */
 
-    bool operator<=(const BigInt &operand) const;
+    inline void checkpoint()
+    {
+        task_control *task = current_task();
+        if (task != nullptr && task->stop.stop_requested())
+            throw std::system_error(std::make_error_code(std::errc::operation_canceled), "BigInt operation was cancelled");
+    }
 
     /**
-     * @brief Overloads the pre-increment operator (++X) for BigInt class
-     * Uses the logic of the overloaded operator `+` to increment the current BigInt object (*this) by 1
-     * the function returns the incremented value of *this
-     *
-     * @return BigInt& A reference to the updated BigInt object (*this)
+     * @brief Runs one chunk of an algorithm that stands for the given fraction of the work of the enclosing chunk, checking for a stop before it and reporting the progress after it
      */
 
-    BigInt &operator++();
+    template <typename Work>
+    void task_step(double fraction, Work &&work)
+    {
+        task_control *task = current_task();
+        if (task == nullptr)
+        {
+            work();
+            return;
+        }
+        checkpoint();
+
+        double parent_begin = task->begin, parent_limit = task->limit;
+        double step_begin = std::min(task->done, parent_limit);
+        double step_limit = std::min(parent_limit, step_begin + (parent_limit - parent_begin) * fraction);
+        task->begin = step_begin;
+        task->limit = step_limit;
+        work();
+        task->begin = parent_begin;
+        task->limit = parent_limit;
+        task->done = std::max(task->done, step_limit);
+        task->report();
+    }
+
+    /**
+     * @brief Hides the asynchronous operation and the instrumentation scope of the calling thread while it runs a queued task of the thread pool, which may belong to another operation
+     * The task sees the stop token of the operation that queued it instead, so the subproducts that run on other threads stop too
+     */
+
+    class foreign_work_guard
+    {
+    public:
+        explicit foreign_work_guard(const std::stop_token &stop) : control{stop, {}}, task(std::exchange(current_task(), stop.stop_possible() ? &control : nullptr))
+#if defined(BIGINT_INSTRUMENTATION)
+                                                                   ,
+                                                                   scope(std::exchange(stat_scope::current(), nullptr))
+#endif
+        {
+        }
+
+        ~foreign_work_guard()
+        {
+            current_task() = task;
+#if defined(BIGINT_INSTRUMENTATION)
+            stat_scope::current() = scope;
+#endif
+        }
+
+        foreign_work_guard(const foreign_work_guard &) = delete;
+        foreign_work_guard &operator=(const foreign_work_guard &) = delete;
+
+    private:
+        task_control control;
+        task_control *task;
+#if defined(BIGINT_INSTRUMENTATION)
+        stat_scope *scope;
+#endif
+    };
+
+    /**
+     * @brief Hands work to the executor as a std::function<void()> and returns the future of its result
+     * The work runs with a task_control installed on the executing thread, so the algorithms it calls see the stop token and report their progress
+     */
+
+    template <typename Result, typename Executor, typename Work>
+    std::future<Result> launch_task(Executor &&executor, std::stop_token stop, std::function<void(double)> progress, Work work)
+    {
+        auto promise = std::make_shared<std::promise<Result>>();
+        std::future<Result> result = promise->get_future();
+        std::function<void()> job = [promise, stop = std::move(stop), progress = std::move(progress), work = std::move(work)]() mutable
+        {
+            task_control control{stop, std::move(progress)};
+            task_control *outer = std::exchange(current_task(), &control);
+            try
+            {
+                checkpoint();
+                Result value = work();
+                control.done = 1;
+                control.report();
+                current_task() = outer;
+                promise->set_value(std::move(value));
+            }
+            catch (...)
+            {
+                current_task() = outer;
+                promise->set_exception(std::current_exception());
+            }
+        };
+        executor(std::move(job));
+        return result;
+    }
+
+    // ---------------------------------------- algorithms built on the kernels ----------------------------------------
+
+    /**
+     * @brief Adds the an-limb array ap and the bn-limb array bp (an >= bn), writes the an-limb sum to rp and returns the carry (0 or 1)
+     */
+
+    limb add(limb *rp, const limb *ap, size_t an, const limb *bp, size_t bn)
+    {
+        limb carry = kernels().add_n(rp, ap, bp, bn);
+        for (size_t i = bn; i < an; ++i)
+        {
+            if (carry == 0 && rp == ap) // in place, the remaining limbs are already right
+                return 0;
+            limb a = ap[i];
+            rp[i] = a + carry;
+            carry = (rp[i] < a) ? 1 : 0;
+        }
+        return carry;
+    }
+
+    /**
+     * @brief Subtracts the bn-limb array bp from the an-limb array ap (an >= bn), writes the an-limb difference to rp and returns the borrow (0 or 1)
+     */
+
+    limb sub(limb *rp, const limb *ap, size_t an, const limb *bp, size_t bn)
+    {
+        limb borrow = kernels().sub_n(rp, ap, bp, bn);
+        for (size_t i = bn; i < an; ++i)
+        {
+            if (borrow == 0 && rp == ap) // in place, the remaining limbs are already right
+                return 0;
+            limb a = ap[i];
+            rp[i] = a - borrow;
+            borrow = (a < borrow) ? 1 : 0;
+        }
+        return borrow;
+    }
+
+    /**
+     * @brief Shifts the n-limb array ap left by count bits (0 < count < 64), writes the low n limbs to rp and returns the bits shifted out
+     * rp may be the same array as ap
+     */
+
+    limb lshift(limb *rp, const limb *ap, size_t n, unsigned count)
+    {
+        limb out = ap[n - 1] >> (64 - count);
+        for (size_t i = n - 1; i > 0; --i)
+            rp[i] = (ap[i] << count) | (ap[i - 1] >> (64 - count));
+        rp[0] = ap[0] << count;
+        return out;
+    }
+
+    /**
+     * @brief Shifts the n-limb array ap right by count bits (0 < count < 64), writes the n limbs to rp and returns the bits shifted out in the high bits of a limb
+     * rp may be the same array as ap
+     */
+
+    limb rshift(limb *rp, const limb *ap, size_t n, unsigned count)
+    {
+        limb out = ap[0] << (64 - count);
+        for (size_t i = 0; i + 1 < n; ++i)
+            rp[i] = (ap[i] >> count) | (ap[i + 1] << (64 - count));
+        rp[n - 1] = ap[n - 1] >> count;
+        return out;
+    }
+
+    /**
+     * @brief Multiplies the an-limb array ap by the bn-limb array bp (an >= bn >= 1) with the schoolbook method and writes the (an + bn)-limb product to rp
+     * rp must not overlap ap or bp
+     */
+
+    void mul_basecase(limb *rp, const limb *ap, size_t an, const limb *bp, size_t bn)
+    {
+        const kernel_table &table = kernels();
+        rp[an] = table.mul_1(rp, ap, an, bp[0]);
+        for (size_t j = 1; j < bn; ++j)
+            rp[an + j] = table.addmul_1(rp + j, ap, an, bp[j]);
+    }
+
+    /**
+     * @brief Returns the reciprocal floor((2^128 - 1) / d) - 2^64 of a normalized limb d (the top bit of d is set)
+     * The reciprocal replaces the hardware division in divrem_1 by two multiplications (Moller and Granlund, Improved division by invariant integers)
+     */
+
+    inline limb reciprocal_word(limb d)
+    {
+        limb rem;
+        return div_wide(~d, ~0ULL, d, rem);
+    }
+
+    /**
+     * @brief Divides the two-limb number (high, low) by the normalized limb d with its reciprocal and returns the quotient, the remainder is written to rem
+     */
+
+    inline limb div_preinv(limb high, limb low, limb d, limb reciprocal, limb &rem)
+    {
+        limb quotient_high;
+        limb quotient_low = mul_wide(reciprocal, high, quotient_high);
+        limb sum_low = quotient_low + low;
+        quotient_high += high + 1 + (sum_low < quotient_low ? 1 : 0);
+        limb r = low - quotient_high * d;
+        if (r > sum_low)
+        {
+            --quotient_high;
+            r += d;
+        }
+        if (r >= d)
+        {
+            ++quotient_high;
+            r -= d;
+        }
+        rem = r;
+        return quotient_high;
+    }
+
+    /**
+     * @brief Divides the n-limb array ap by the non-zero limb d, writes the n-limb quotient to qp and returns the remainder
+     * qp may be the same array as ap
+     */
+
+    limb divrem_1(limb *qp, const limb *ap, size_t n, limb d)
+    {
+        if (n == 0)
+            return 0;
+        unsigned shift = static_cast<unsigned>(count_leading_zeros(d));
+        d <<= shift;
+        limb reciprocal = reciprocal_word(d);
+        limb rem = 0;
+        if (shift == 0)
+        {
+            for (size_t i = n; i > 0; --i)
+                qp[i - 1] = div_preinv(rem, ap[i - 1], d, reciprocal, rem);
+            return rem;
+        }
+        rem = ap[n - 1] >> (64 - shift);
+        for (size_t i = n; i > 0; --i)
+        {
+            limb next = (i > 1) ? ap[i - 2] >> (64 - shift) : 0;
+            qp[i - 1] = div_preinv(rem, (ap[i - 1] << shift) | next, d, reciprocal, rem);
+        }
+        return rem >> shift;
+    }
+
+    /**
+     * @brief Divides the an-limb array ap by the dn-limb array dp (an >= dn >= 2, top limb of dp non-zero) with Knuth's algorithm D
+     * Writes the (an - dn + 1)-limb quotient to qp and the dn-limb remainder to rp, neither of which may overlap the inputs
+     * scratch must hold an + 1 + dn limbs for the normalized divisor and the running remainder
+     */
+
+    void divrem(limb *qp, limb *rp, const limb *ap, size_t an, const limb *dp, size_t dn, limb *scratch)
+    {
+        const kernel_table &table = kernels();
+        unsigned shift = static_cast<unsigned>(count_leading_zeros(dp[dn - 1]));
+
+        limb *divisor = scratch; // normalized so the top bit of the divisor is set
+        limb *remainder = scratch + dn;
+        if (shift != 0)
+        {
+            lshift(divisor, dp, dn, shift);
+            remainder[an] = lshift(remainder, ap, an, shift);
+        }
+        else
+        {
+            std::copy(dp, dp + dn, divisor);
+            std::copy(ap, ap + an, remainder);
+            remainder[an] = 0;
+        }
+
+        limb divisor_high = divisor[dn - 1];
+        limb divisor_next = divisor[dn - 2];
+        limb reciprocal = reciprocal_word(divisor_high);
+
+        for (size_t j = an - dn + 1; j > 0; --j)
+        {
+            limb *window = remainder + (j - 1);
+            limb top = window[dn];
+            limb quotient_digit;
+            limb rem;
+            bool rem_overflow = false;
+
+            if (top >= divisor_high) // the estimate would not fit in a limb, so start from the largest limb
+            {
+                quotient_digit = ~0ULL;
+                rem = window[dn - 1] + divisor_high;
+                rem_overflow = rem < divisor_high;
+            }
+            else
+            {
+                quotient_digit = div_preinv(top, window[dn - 1], divisor_high, reciprocal, rem);
+            }
+
+            while (!rem_overflow) // refines the estimate with the second limb of the divisor, it is then at most one too large
+            {
+                limb product_high;
+                limb product_low = mul_wide(quotient_digit, divisor_next, product_high);
+                if (product_high < rem || (product_high == rem && product_low <= window[dn - 2]))
+                    break;
+                --quotient_digit;
+                rem += divisor_high;
+                rem_overflow = rem < divisor_high;
+            }
+
+            limb borrow = table.submul_1(window, divisor, dn, quotient_digit);
+            window[dn] = top - borrow;
+            if (top < borrow) // the estimate was one too large, so add the divisor back
+            {
+                --quotient_digit;
+                window[dn] += table.add_n(window, window, divisor, dn);
+            }
+            qp[j - 1] = quotient_digit;
+        }
+
+        if (shift != 0)
+            rshift(rp, remainder, dn, shift);
+        else
+            std::copy(remainder, remainder + dn, rp);
+    }
+
+    // ---------------------------------------- exact division ----------------------------------------
+
+    /**
+     * @brief Returns the inverse of the odd limb d modulo 2^64, so that d * inverse = 1 (mod 2^64)
+     * 3d xor 2 is correct to 5 bits, and every Newton step x = x (2 - d x) doubles the number of correct bits
+     */
+
+    inline limb binvert_limb(limb d)
+    {
+        limb inverse = (3 * d) ^ 2;
+        for (int i = 0; i < 4; ++i)
+            inverse *= 2 - d * inverse;
+        return inverse;
+    }
+
+    /**
+     * @brief Divides the n-limb array ap by the odd limb d when the division is known to be exact, and writes the n-limb quotient to qp
+     * Works from the low limb up with the 2-adic inverse of d (Hensel division), so every quotient limb is one multiplication instead of a division
+     * qp may be the same array as ap. If d does not divide ap the result is meaningless
+     */
+
+    void divexact_1(limb *qp, const limb *ap, size_t n, limb d)
+    {
+        limb inverse = binvert_limb(d);
+        limb borrow = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb a = ap[i];
+            limb difference = a - borrow;
+            limb next_borrow = (a < borrow) ? 1 : 0;
+            limb quotient_digit = difference * inverse;
+            qp[i] = quotient_digit;
+            limb high;
+            mul_wide(quotient_digit, d, high);
+            borrow = high + next_borrow;
+        }
+    }
+
+    /**
+     * @brief Returns zero if and only if the odd limb d divides the n-limb array ap
+     * The Hensel division of divexact_1 without the quotient: what is left after the last limb is zero exactly when nothing had to be carried out of ap
+     */
+
+    limb modexact_1_odd(const limb *ap, size_t n, limb d)
+    {
+        limb inverse = binvert_limb(d);
+        limb borrow = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb a = ap[i];
+            limb difference = a - borrow;
+            limb next_borrow = (a < borrow) ? 1 : 0;
+            limb high;
+            mul_wide(difference * inverse, d, high);
+            borrow = high + next_borrow;
+        }
+        return borrow;
+    }
+
+    /**
+     * @brief Subtracts the borrow (0 or 1) from the n-limb array rp in place and returns the borrow out of its top limb
+     */
+
+    inline limb sub_borrow(limb *rp, size_t n, limb borrow)
+    {
+        for (size_t i = 0; i < n && borrow != 0; ++i)
+        {
+            borrow = (rp[i] == 0) ? 1 : 0;
+            --rp[i];
+        }
+        return borrow;
+    }
+
+    /**
+     * @brief Divides the an-limb array ap by the odd dn-limb array dp (an >= dn, top limb of dp non-zero) when the division is known to be exact (Jebelean's method)
+     * Writes the (an - dn + 1)-limb quotient to qp. The quotient limbs are found from the bottom with the 2-adic inverse of the low limb of dp, and since only the low an - dn + 1 limbs of ap - q dp matter, each step subtracts at most that many limbs
+     * scratch must hold an - dn + 1 limbs, and qp must not overlap ap, dp or the scratch. If dp does not divide ap the result is meaningless
+     */
+
+    void divexact(limb *qp, const limb *ap, size_t an, const limb *dp, size_t dn, limb *scratch)
+    {
+        const kernel_table &table = kernels();
+        size_t qn = an - dn + 1;
+        limb inverse = binvert_limb(dp[0]);
+        limb *remainder = scratch;
+        std::copy(ap, ap + qn, remainder);
+
+        for (size_t i = 0; i < qn; ++i)
+        {
+            limb quotient_digit = remainder[i] * inverse;
+            qp[i] = quotient_digit;
+            size_t length = std::min(dn, qn - i);
+            limb borrow = table.submul_1(remainder + i, dp, length, quotient_digit);
+            // the borrow limb is subtracted one limb above, and anything carried past limb qn is dropped
+            if (i + length < qn)
+            {
+                limb top = remainder[i + length];
+                remainder[i + length] = top - borrow;
+                sub_borrow(remainder + i + length + 1, qn - i - length - 1, (top < borrow) ? 1 : 0);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns true if the odd dn-limb array dp divides the an-limb array ap (an >= dn, top limb of dp non-zero), without storing a quotient
+     * Clears ap limb by limb from the bottom like divexact. What is left, (ap - q dp) / B^(an - dn + 1), lies strictly between -dp and dp and is divisible by dp exactly when ap is, so it has to be zero
+     * scratch must hold an limbs
+     */
+
+    bool divisible(const limb *ap, size_t an, const limb *dp, size_t dn, limb *scratch)
+    {
+        const kernel_table &table = kernels();
+        size_t qn = an - dn + 1;
+        limb inverse = binvert_limb(dp[0]);
+        limb *remainder = scratch;
+        std::copy(ap, ap + an, remainder);
+
+        for (size_t i = 0; i < qn; ++i)
+        {
+            limb quotient_digit = remainder[i] * inverse;
+            limb borrow = table.submul_1(remainder + i, dp, dn, quotient_digit);
+            if (i + dn == an)
+                return borrow == 0 && std::all_of(remainder + qn, remainder + an, [](limb x)
+                                                  { return x == 0; });
+            limb top = remainder[i + dn];
+            remainder[i + dn] = top - borrow;
+            if (sub_borrow(remainder + i + dn + 1, an - i - dn - 1, (top < borrow) ? 1 : 0) != 0)
+                return false; // ap - q dp went negative, and it only decreases from here
+        }
+        return false;
+    }
+
+    // ---------------------------------------- greatest common divisor ----------------------------------------
+
+    /**
+     * @brief Returns the 62 bits of the n-limb array ap that start at bit position shift, the part of the operands that Lehmer's method works on
+     */
+
+    inline limb bits_at(const limb *ap, size_t n, size_t shift)
+    {
+        size_t index = shift / 64;
+        unsigned offset = static_cast<unsigned>(shift % 64);
+        limb bits = (index < n) ? ap[index] >> offset : 0;
+        if (offset != 0 && index + 1 < n)
+            bits |= ap[index + 1] << (64 - offset);
+        return bits & ((1ULL << 62) - 1);
+    }
+
+    /**
+     * @brief Writes x a + y b to rp, where a and b are n-limb arrays and the result is known to be non-negative and to fit in n limbs
+     * This is one half of a Lehmer step, whose cofactors x and y never have the same sign
+     */
+
+    void combine_cofactors(limb *rp, const limb *ap, const limb *bp, size_t n, int64_t x, int64_t y)
+    {
+        const kernel_table &table = kernels();
+        if (y <= 0)
+        {
+            table.mul_1(rp, ap, n, static_cast<limb>(x));
+            table.submul_1(rp, bp, n, static_cast<limb>(-y));
+        }
+        else
+        {
+            table.mul_1(rp, bp, n, static_cast<limb>(y));
+            table.submul_1(rp, ap, n, static_cast<limb>(-x));
+        }
+    }
+
+    /**
+     * @brief Returns the greatest common divisor of two magnitudes with Lehmer's method, the inputs are overwritten
+     * Every step runs Euclid's algorithm on the top 62 bits of both numbers with single-limb arithmetic, as long as the quotients are certain to be those of the full numbers (Knuth's Algorithm L), and then applies the accumulated 2x2 cofactor matrix to the full numbers in two linear passes
+     * When the top bits give no certain quotient, which happens when the sizes differ a lot, one full division step is taken instead
+     */
+
+    std::vector<limb> gcd(std::vector<limb> a, std::vector<limb> b)
+    {
+        auto trim = [](std::vector<limb> &v)
+        {
+            while (!v.empty() && v.back() == 0)
+                v.pop_back();
+        };
+        auto less = [](const std::vector<limb> &left, const std::vector<limb> &right)
+        {
+            if (left.size() != right.size())
+                return left.size() < right.size();
+            return std::lexicographical_compare(left.rbegin(), left.rend(), right.rbegin(), right.rend());
+        };
+        trim(a);
+        trim(b);
+        if (less(a, b))
+            std::swap(a, b);
+
+        std::vector<limb> next_a, next_b, scratch;
+        while (b.size() >= 2)
+        {
+            size_t n = a.size();
+            size_t shift = 64 * n - static_cast<size_t>(count_leading_zeros(a[n - 1])) - 62;
+            int64_t a_high = static_cast<int64_t>(bits_at(a.data(), n, shift));
+            int64_t b_high = static_cast<int64_t>(bits_at(b.data(), b.size(), shift));
+
+            int64_t x0 = 1, y0 = 0, x1 = 0, y1 = 1; // a' = x0 a + y0 b and b' = x1 a + y1 b
+            while (b_high + x1 != 0 && b_high + y1 != 0)
+            {
+                int64_t quotient = (a_high + x0) / (b_high + x1);
+                if (quotient != (a_high + y0) / (b_high + y1))
+                    break;
+                int64_t t = x0 - quotient * x1;
+                x0 = x1;
+                x1 = t;
+                t = y0 - quotient * y1;
+                y0 = y1;
+                y1 = t;
+                t = a_high - quotient * b_high;
+                a_high = b_high;
+                b_high = t;
+            }
+
+            if (y0 == 0) // no certain quotient: a full division step (a, b) = (b, a mod b)
+            {
+                next_a.resize(n - b.size() + 1);
+                next_b.resize(b.size());
+                scratch.resize(n + 1 + b.size());
+                divrem(next_a.data(), next_b.data(), a.data(), n, b.data(), b.size(), scratch.data());
+                std::swap(a, b);
+                std::swap(b, next_b);
+            }
+            else
+            {
+                b.resize(n, 0);
+                next_a.resize(n);
+                next_b.resize(n);
+                combine_cofactors(next_a.data(), a.data(), b.data(), n, x0, y0);
+                combine_cofactors(next_b.data(), a.data(), b.data(), n, x1, y1);
+                std::swap(a, next_a);
+                std::swap(b, next_b);
+            }
+            trim(a);
+            trim(b);
+        }
+
+        if (b.empty())
+            return a;
+
+        // a single-limb b: one division brings a down to a limb too, then Euclid finishes on limbs
+        limb small_b = b[0];
+        limb small_a = divrem_1(a.data(), a.data(), a.size(), small_b);
+        while (small_a != 0)
+        {
+            limb remainder = small_b % small_a;
+            small_b = small_a;
+            small_a = remainder;
+        }
+        return std::vector<limb>{small_b};
+    }
+
+    // ---------------------------------------- work-stealing thread pool ----------------------------------------
+
+    /**
+     * @brief A small work-stealing thread pool used to spread independent subproducts over several cores
+     * Every worker owns a deque of tasks: it pops its own tasks from the back and steals from the front of the other deques when it runs out
+     * invoke() runs a group of functions and returns when all of them are done; the calling thread runs the first function itself and then helps with queued tasks instead of blocking, so nested invoke() calls cannot deadlock
+     */
+
+    class thread_pool
+    {
+    public:
+        explicit thread_pool(unsigned worker_count)
+        {
+            for (unsigned i = 0; i <= worker_count; ++i) // the extra queue receives the tasks of threads that are not workers
+                queues.push_back(std::make_unique<task_queue>());
+            for (unsigned i = 0; i < worker_count; ++i)
+                workers.emplace_back([this, i]
+                                     { worker_loop(i); });
+        }
+
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (std::thread &worker : workers)
+                worker.join();
+        }
+
+        thread_pool(const thread_pool &) = delete;
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        /**
+         * @brief Returns the number of threads that run tasks, including the calling thread
+         */
+
+        unsigned size() const
+        {
+            return static_cast<unsigned>(workers.size()) + 1;
+        }
+
+        /**
+         * @brief Runs all the functions, possibly in parallel, and returns when every one of them has finished
+         * If a function throws, the first exception is rethrown after all of them are done
+         */
+
+        template <typename... Functions>
+        void invoke(Functions &&...functions)
+        {
+            std::function<void()> group[] = {std::function<void()>(std::forward<Functions>(functions))...};
+            run(group, sizeof...(Functions));
+        }
+
+        /**
+         * @brief Runs count functions, possibly in parallel, and returns when every one of them has finished
+         * The calling thread runs the first function itself, queues the others and then helps with queued tasks until its own are done
+         */
+
+        void run(std::function<void()> *functions, size_t count)
+        {
+            if (count == 0)
+                return;
+
+            std::unique_ptr<task[]> tasks(new task[count - 1]);
+            task_queue &own = *queues[queue_index()];
+            task_control *owner = current_task();
+            {
+                std::lock_guard<std::mutex> lock(own.mutex);
+                for (size_t i = 1; i < count; ++i)
+                {
+                    tasks[i - 1].work = std::move(functions[i]);
+                    if (owner != nullptr)
+                        tasks[i - 1].stop = owner->stop;
+                    own.tasks.push_back(&tasks[i - 1]);
+                }
+            }
+            pending.fetch_add(count - 1);
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex); // a worker between checking pending and going to sleep holds this mutex, so the wake-up cannot be lost
+            }
+            wake.notify_all();
+
+            std::exception_ptr error;
+            try
+            {
+                functions[0]();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            for (size_t i = 0; i + 1 < count; ++i)
+            {
+                while (!tasks[i].done.load(std::memory_order_acquire))
+                {
+                    if (!run_one())
+                        std::this_thread::yield();
+                }
+                if (tasks[i].error && !error)
+                    error = tasks[i].error;
+            }
+
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+    private:
+        struct task
+        {
+            std::function<void()> work;
+            std::stop_token stop; // the stop token of the asynchronous operation that queued the task, if any
+            std::exception_ptr error;
+            std::atomic<bool> done{false};
+        };
+
+        struct task_queue
+        {
+            std::mutex mutex;
+            std::deque<task *> tasks;
+        };
+
+        std::vector<std::unique_ptr<task_queue>> queues;
+        std::vector<std::thread> workers;
+        std::atomic<size_t> pending{0};
+        std::mutex sleep_mutex;
+        std::condition_variable wake;
+        bool stopping = false;
+
+        static int &worker_id()
+        {
+            thread_local int id = -1;
+            return id;
+        }
+
+        size_t queue_index() const
+        {
+            int id = worker_id();
+            size_t shared_queue = queues.size() - 1; // queues is complete before the first worker starts, unlike workers
+            return (id >= 0 && static_cast<size_t>(id) < shared_queue) ? static_cast<size_t>(id) : shared_queue;
+        }
+
+        /**
+         * @brief Runs one task from the calling thread's own queue or steals one from another queue, and returns false if every queue is empty
+         */
+
+        bool run_one()
+        {
+            size_t own = queue_index();
+            task *next = nullptr;
+            for (size_t offset = 0; offset < queues.size() && next == nullptr; ++offset)
+            {
+                task_queue &queue = *queues[(own + offset) % queues.size()];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.tasks.empty())
+                    continue;
+                if (offset == 0) // own queue: newest task first, it is the most likely to be in cache
+                {
+                    next = queue.tasks.back();
+                    queue.tasks.pop_back();
+                }
+                else // stealing: oldest task first, it is usually the largest one
+                {
+                    next = queue.tasks.front();
+                    queue.tasks.pop_front();
+                }
+            }
+            if (next == nullptr)
+                return false;
+
+            pending.fetch_sub(1);
+            try
+            {
+                foreign_work_guard guard(next->stop);
+                next->work();
+            }
+            catch (...)
+            {
+                next->error = std::current_exception();
+            }
+            next->done.store(true, std::memory_order_release); // the owner may destroy the task right after this store
+            return true;
+        }
+
+        void worker_loop(unsigned id)
+        {
+            worker_id() = static_cast<int>(id);
+            while (true)
+            {
+                if (run_one())
+                    continue;
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                wake.wait(lock, [this]
+                          { return stopping || pending.load() > 0; });
+                if (stopping)
+                    return;
+            }
+        }
+    };
+
+    /**
+     * @brief The settings of the parallel mode shared by all BigInt objects
+     * threads is the total number of threads used for one operation (1 means serial) and grain is the operand size in limbs below which work is never split
+     * The settings are changed through BigInt::setthreads() and BigInt::setgrainsize(), which must not be called while other threads are computing with BigInt objects
+     */
+
+    struct parallel_settings
+    {
+        std::mutex mutex;
+        unsigned threads = 1;
+        size_t grain = 2048;
+        std::unique_ptr<thread_pool> pool;
+    };
+
+    parallel_settings &parallel()
+    {
+        static parallel_settings settings;
+        return settings;
+    }
+
+    /**
+     * @brief Returns the thread pool if the parallel mode is on and the operand of n limbs is above the grain size, otherwise nullptr
+     */
+
+    thread_pool *pool_for(size_t n)
+    {
+        parallel_settings &settings = parallel();
+        if (settings.threads <= 1 || n < settings.grain)
+            return nullptr;
+        return settings.pool.get();
+    }
+
+    /**
+     * @brief Calls body(begin, end) on consecutive ranges of at most block elements that together cover [0, count)
+     * When the parallel mode is on and there is more than one range, the ranges are handed to the thread pool as a few tasks per thread so that work stealing can balance uneven ranges
+     */
+
+    template <typename Function>
+    void parallel_for(size_t count, size_t block, Function &&body)
+    {
+        size_t blocks = (count + block - 1) / block;
+        parallel_settings &settings = parallel();
+        if (settings.threads <= 1 || blocks <= 1)
+        {
+            for (size_t begin = 0; begin < count; begin += block)
+                body(begin, std::min(count, begin + block));
+            return;
+        }
+
+        size_t tasks = std::min<size_t>(blocks, 4 * static_cast<size_t>(settings.threads));
+        std::vector<std::function<void()>> task_bodies;
+        for (size_t task = 0; task < tasks; ++task)
+        {
+            size_t first_block = task * blocks / tasks;
+            size_t last_block = (task + 1) * blocks / tasks;
+            task_bodies.emplace_back([&body, first_block, last_block, block, count]
+                                     {
+                                         for (size_t b = first_block; b < last_block; ++b)
+                                             body(b * block, std::min(count, (b + 1) * block)); });
+        }
+        settings.pool->run(task_bodies.data(), task_bodies.size());
+    }
+
+    // ---------------------------------------- random limbs ----------------------------------------
+
+    /**
+     * @brief The number of limbs that fill_random draws from one engine before it switches to a freshly seeded one
+     */
+
+    constexpr size_t random_chunk = size_t{1} << 16;
+
+    /**
+     * @brief Fills the n-limb array rp with uniform random limbs drawn from a 64-bit engine
+     * Arrays of more than random_chunk limbs are cut into chunks that each get an engine of the same type seeded with one limb of the caller's engine, so the chunks are independent and fill in parallel when the parallel mode is on
+     * The chunks only depend on n, so the result is the same with and without threads; engines that cannot be seeded with a limb fill the array in one stream
+     */
+
+    template <typename Engine>
+    void fill_random(limb *rp, size_t n, Engine &engine)
+    {
+        if constexpr (std::is_constructible_v<Engine, limb>)
+        {
+            if (n > random_chunk)
+            {
+                size_t chunks = (n + random_chunk - 1) / random_chunk;
+                std::vector<limb> seeds(chunks);
+                for (limb &seed : seeds)
+                    seed = engine();
+
+                auto fill_chunk = [&](size_t chunk)
+                {
+                    Engine chunk_engine(seeds[chunk]);
+                    size_t end = std::min(n, (chunk + 1) * random_chunk);
+                    for (size_t i = chunk * random_chunk; i < end; ++i)
+                        rp[i] = chunk_engine();
+                };
+
+                if (thread_pool *pool = pool_for(n))
+                {
+                    // the chunks are dealt round-robin into one group per thread, like the pieces of mul_unbalanced
+                    size_t groups = std::min<size_t>(pool->size(), chunks);
+                    std::vector<std::function<void()>> group_tasks;
+                    for (size_t group = 0; group < groups; ++group)
+                        group_tasks.emplace_back([&, group]
+                                                 {
+                                                     for (size_t chunk = group; chunk < chunks; chunk += groups)
+                                                         fill_chunk(chunk); });
+                    pool->run(group_tasks.data(), group_tasks.size());
+                }
+                else
+                {
+                    for (size_t chunk = 0; chunk < chunks; ++chunk)
+                        fill_chunk(chunk);
+                }
+                return;
+            }
+        }
+
+        for (size_t i = 0; i < n; ++i)
+            rp[i] = engine();
+    }
+
+    // ---------------------------------------- multiplication ----------------------------------------
+
+    /**
+     * @brief Operand size in limbs below which the schoolbook method is faster than Karatsuba
+     */
+
+    constexpr size_t karatsuba_threshold = 48;
+
+    /**
+     * @brief Returns the number of scratch limbs that mul needs for an an-limb by bn-limb product (an >= bn)
+     * Karatsuba needs 2 (half + 1) limbs for the middle product plus the scratch of a product of half + 1 limbs (the sums are kept in the result until z0 and z2 overwrite them), unbalanced products need one piece product plus the scratch of a balanced bn-limb product
+     */
+
+    size_t mul_scratch_size(size_t an, size_t bn)
+    {
+        if (bn < karatsuba_threshold)
+            return 0;
+        if (bn <= (an + 1) / 2)
+            return 2 * bn + mul_scratch_size(bn, bn);
+        size_t size = 0;
+        for (size_t n = an; n >= karatsuba_threshold; n = (n + 1) / 2 + 1)
+            size += 2 * ((n + 1) / 2 + 1);
+        return size;
+    }
+
+    void mul(limb *rp, const limb *ap, size_t an, const limb *bp, size_t bn, limb *scratch);
+    void sqr(limb *rp, const limb *ap, size_t n, limb *scratch);
+
+    /**
+     * @brief Subtracts z0 (2 half limbs at rp) and z2 (high_size limbs at rp + 2 half) from the middle product and adds it at rp + half, the last step of Karatsuba
+     */
+
+    void karatsuba_combine(limb *rp, size_t half, size_t high_size, size_t total, limb *middle, size_t middle_size)
+    {
+        // middle -= z0 + z2, which cannot go negative
+        sub(middle, middle, middle_size, rp, 2 * half);
+        sub(middle, middle, middle_size, rp + 2 * half, high_size);
+        while (middle_size > 0 && middle[middle_size - 1] == 0)
+            --middle_size;
+
+        add(rp + half, rp + half, total - half, middle, middle_size);
+    }
+
+    /**
+     * @brief Multiplies with Karatsuba's method, the high half of the longer operand must be shorter than the shorter operand (an >= bn > ceil(an / 2))
+     * The operands are split at half = ceil(an / 2) limbs and the product is z2 * B^(2 half) + ((a0 + a1)(b0 + b1) - z0 - z2) * B^half + z0
+     * The sums sit in rp until the middle product has used them and z0 and z2 overwrite them, the middle product lives in the scratch, and the three half-size products share the rest of it one after the other
+     * Above the grain size the three products run in parallel on the thread pool, and then the sums and two of the products allocate their own memory
+     */
+
+    void mul_karatsuba(limb *rp, const limb *ap, size_t an, const limb *bp, size_t bn, limb *scratch)
+    {
+        size_t half = (an + 1) / 2;
+        size_t a_high = an - half, b_high = bn - half;
+        thread_pool *pool = pool_for(bn);
+
+        std::vector<limb> parallel_sums(pool != nullptr ? 2 * half + 2 : 0);
+        limb *a_sum = (pool != nullptr) ? parallel_sums.data() : rp;
+        limb *b_sum = a_sum + half + 1;
+        limb *middle = scratch;
+        limb *inner = middle + 2 * half + 2;
+
+        a_sum[half] = add(a_sum, ap, half, ap + half, a_high);
+        b_sum[half] = add(b_sum, bp, half, bp + half, b_high);
+        size_t a_sum_size = half + (a_sum[half] != 0 ? 1 : 0);
+        size_t b_sum_size = half + (b_sum[half] != 0 ? 1 : 0);
+        if (a_sum_size < b_sum_size)
+        {
+            std::swap(a_sum, b_sum);
+            std::swap(a_sum_size, b_sum_size);
+        }
+
+        if (pool != nullptr)
+        {
+            std::vector<limb> low_scratch(mul_scratch_size(half, half)), high_scratch(mul_scratch_size(a_high, b_high));
+            pool->invoke([&]
+                         { mul(middle, a_sum, a_sum_size, b_sum, b_sum_size, inner); },
+                         [&]
+                         { mul(rp, ap, half, bp, half, low_scratch.data()); },
+                         [&]
+                         { mul(rp + 2 * half, ap + half, a_high, bp + half, b_high, high_scratch.data()); });
+        }
+        else // the three products are the chunks at which an asynchronous multiplication can stop, the middle one first since it reads the sums in rp
+        {
+            task_step(1.0 / 3, [&]
+                      { mul(middle, a_sum, a_sum_size, b_sum, b_sum_size, inner); });
+            task_step(1.0 / 3, [&]
+                      { mul(rp, ap, half, bp, half, inner); });
+            task_step(1.0 / 3, [&]
+                      { mul(rp + 2 * half, ap + half, a_high, bp + half, b_high, inner); });
+        }
+
+        karatsuba_combine(rp, half, a_high + b_high, an + bn, middle, a_sum_size + b_sum_size);
+    }
+
+    /**
+     * @brief Multiplies a long operand by a much shorter one (bn <= ceil(an / 2)) by cutting the long operand into pieces of bn limbs
+     * Each piece is a balanced product that is added into rp from the scratch, and above the grain size the pieces are computed in parallel
+     */
+
+    void mul_unbalanced(limb *rp, const limb *ap, size_t an, const limb *bp, size_t bn, limb *scratch)
+    {
+        size_t pieces = (an + bn - 1) / bn;
+        auto piece_product = [&](size_t piece, limb *destination, limb *piece_scratch)
+        {
+            size_t offset = piece * bn;
+            size_t length = std::min(bn, an - offset);
+            if (length >= bn)
+                mul(destination, ap + offset, length, bp, bn, piece_scratch);
+            else
+                mul(destination, bp, bn, ap + offset, length, piece_scratch);
+        };
+
+        thread_pool *pool = pool_for(bn);
+        if (pool != nullptr && pieces > 1)
+        {
+            std::vector<std::vector<limb>> products(pieces);
+
+            // the pieces are dealt round-robin into one group per thread
+            size_t groups = std::min<size_t>(pool->size(), pieces);
+            std::vector<std::function<void()>> group_tasks;
+            for (size_t group = 0; group < groups; ++group)
+                group_tasks.emplace_back([&, group]
+                                         {
+                                             std::vector<limb> group_scratch(mul_scratch_size(bn, bn));
+                                             for (size_t piece = group; piece < pieces; piece += groups)
+                                             {
+                                                 products[piece].resize(std::min(bn, an - piece * bn) + bn);
+                                                 piece_product(piece, products[piece].data(), group_scratch.data());
+                                             } });
+            pool->run(group_tasks.data(), group_tasks.size());
+
+            std::fill(rp, rp + an + bn, 0);
+            for (size_t piece = 0; piece < pieces; ++piece)
+            {
+                size_t offset = piece * bn;
+                add(rp + offset, rp + offset, an + bn - offset, products[piece].data(), products[piece].size());
+            }
+            return;
+        }
+
+        // the first piece goes straight to rp, every later one overlaps the top bn limbs of the previous one
+        limb *product = scratch;
+        limb *inner = scratch + 2 * bn;
+        double fraction = 1.0 / static_cast<double>(pieces);
+        task_step(fraction, [&]
+                  { piece_product(0, rp, inner); });
+        for (size_t piece = 1; piece < pieces; ++piece)
+        {
+            size_t offset = piece * bn;
+            size_t length = std::min(bn, an - offset);
+            task_step(fraction, [&]
+                      { piece_product(piece, product, inner); });
+            limb carry = kernels().add_n(rp + offset, rp + offset, product, bn);
+            std::copy(product + bn, product + bn + length, rp + offset + bn);
+            for (size_t i = offset + bn; carry != 0 && i < an + bn; ++i)
+            {
+                rp[i] += carry;
+                carry = (rp[i] == 0) ? 1 : 0;
+            }
+        }
+    }
+
+    /**
+     * @brief Multiplies the an-limb array ap by the bn-limb array bp (an >= bn >= 1) and writes the (an + bn)-limb product to rp
+     * Chooses the schoolbook method for short operands, Karatsuba for balanced ones and splits unbalanced ones into balanced pieces
+     * scratch must hold mul_scratch_size(an, bn) limbs, and rp must not overlap ap, bp or the scratch
+     */
+
+    void mul(limb *rp, const limb *ap, size_t an, const limb *bp, size_t bn, limb *scratch)
+    {
+        if (bn < karatsuba_threshold)
+        {
+            note_tier(BigIntTier::basecase);
+            mul_basecase(rp, ap, an, bp, bn);
+        }
+        else if (bn <= (an + 1) / 2) // Karatsuba needs the shorter operand to reach into the high half of the longer one
+        {
+            note_tier(BigIntTier::unbalanced);
+            mul_unbalanced(rp, ap, an, bp, bn, scratch);
+        }
+        else
+        {
+            note_tier(BigIntTier::karatsuba);
+            mul_karatsuba(rp, ap, an, bp, bn, scratch);
+        }
+    }
+
+    // ---------------------------------------- squaring ----------------------------------------
+
+    /**
+     * @brief Squares the n-limb array ap with the schoolbook method and writes the 2n-limb square to rp
+     * Every cross product a_i a_j (i < j) is computed once and doubled with a shift, then the squares a_i^2 are added on the diagonal, which is about half the work of mul_basecase
+     */
+
+    void sqr_basecase(limb *rp, const limb *ap, size_t n)
+    {
+        const kernel_table &table = kernels();
+        rp[0] = 0;
+        rp[2 * n - 1] = 0;
+        if (n > 1)
+        {
+            rp[n] = table.mul_1(rp + 1, ap + 1, n - 1, ap[0]);
+            for (size_t i = 1; i + 1 < n; ++i)
+                rp[n + i] = table.addmul_1(rp + 2 * i + 1, ap + i + 1, n - i - 1, ap[i]);
+            lshift(rp, rp, 2 * n, 1);
+        }
+
+        limb carry = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb high;
+            limb low = mul_wide(ap[i], ap[i], high);
+            limb sum_low = rp[2 * i] + carry;
+            limb carry_low = (sum_low < carry) ? 1 : 0;
+            sum_low += low;
+            carry_low += (sum_low < low) ? 1 : 0;
+            limb sum_high = rp[2 * i + 1] + carry_low;
+            carry = (sum_high < carry_low) ? 1 : 0;
+            sum_high += high;
+            carry += (sum_high < high) ? 1 : 0;
+            rp[2 * i] = sum_low;
+            rp[2 * i + 1] = sum_high;
+        }
+    }
+
+    /**
+     * @brief Squares with Karatsuba's method as (a0 + a1)^2 - a0^2 - a1^2 for the middle term, three half-size squares instead of three products
+     */
+
+    void sqr_karatsuba(limb *rp, const limb *ap, size_t n, limb *scratch)
+    {
+        size_t half = (n + 1) / 2;
+        size_t a_high = n - half;
+        thread_pool *pool = pool_for(n);
+
+        // as in mul_karatsuba, the sum sits in rp unless the three squares run at once
+        std::vector<limb> parallel_sum(pool != nullptr ? half + 1 : 0);
+        limb *a_sum = (pool != nullptr) ? parallel_sum.data() : rp;
+        limb *middle = scratch;
+        limb *inner = middle + 2 * half + 2;
+
+        a_sum[half] = add(a_sum, ap, half, ap + half, a_high);
+        size_t a_sum_size = half + (a_sum[half] != 0 ? 1 : 0);
+
+        if (pool != nullptr)
+        {
+            std::vector<limb> low_scratch(mul_scratch_size(half, half)), high_scratch(mul_scratch_size(a_high, a_high));
+            pool->invoke([&]
+                         { sqr(middle, a_sum, a_sum_size, inner); },
+                         [&]
+                         { sqr(rp, ap, half, low_scratch.data()); },
+                         [&]
+                         { sqr(rp + 2 * half, ap + half, a_high, high_scratch.data()); });
+        }
+        else
+        {
+            task_step(1.0 / 3, [&]
+                      { sqr(middle, a_sum, a_sum_size, inner); });
+            task_step(1.0 / 3, [&]
+                      { sqr(rp, ap, half, inner); });
+            task_step(1.0 / 3, [&]
+                      { sqr(rp + 2 * half, ap + half, a_high, inner); });
+        }
+
+        karatsuba_combine(rp, half, 2 * a_high, 2 * n, middle, 2 * a_sum_size);
+    }
+
+    /**
+     * @brief Squares the n-limb array ap (n >= 1) and writes the 2n-limb square to rp
+     * scratch must hold mul_scratch_size(n, n) limbs, and rp must not overlap ap or the scratch
+     */
+
+    void sqr(limb *rp, const limb *ap, size_t n, limb *scratch)
+    {
+        if (n < karatsuba_threshold)
+        {
+            note_tier(BigIntTier::basecase);
+            sqr_basecase(rp, ap, n);
+        }
+        else
+        {
+            note_tier(BigIntTier::karatsuba);
+            sqr_karatsuba(rp, ap, n, scratch);
+        }
+    }
+
+    // ---------------------------------------- Hensel reduction ----------------------------------------
+
+    /**
+     * @brief Multiplies the an-limb array ap by the bn-limb array bp in either order of sizes and writes the (an + bn)-limb product to rp, resizing scratch as needed
+     */
+
+    inline void mul_any(limb *rp, const limb *ap, size_t an, const limb *bp, size_t bn, std::vector<limb> &scratch)
+    {
+        if (an < bn)
+        {
+            std::swap(ap, bp);
+            std::swap(an, bn);
+        }
+        scratch.resize(std::max(scratch.size(), mul_scratch_size(an, bn)));
+        mul(rp, ap, an, bp, bn, scratch.data());
+    }
+
+    /**
+     * @brief Writes the low n limbs of the product of the n-limb arrays ap and bp to rp (rp must not overlap them), about half the work of the full product
+     * The low halves are multiplied in full, and the two cross products only contribute their low limbs, which are again low products
+     */
+
+    void mullo(limb *rp, const limb *ap, const limb *bp, size_t n, std::vector<limb> &scratch)
+    {
+        const kernel_table &table = kernels();
+        if (n < karatsuba_threshold)
+        {
+            std::fill(rp, rp + n, 0);
+            for (size_t i = 0; i < n; ++i)
+                table.addmul_1(rp + i, bp, n - i, ap[i]);
+            return;
+        }
+
+        size_t high = n / 2, low = n - high;
+        std::vector<limb> product(2 * low), cross(high);
+        mul_any(product.data(), ap, low, bp, low, scratch);
+        std::copy(product.begin(), product.begin() + static_cast<std::ptrdiff_t>(n), rp);
+        mullo(cross.data(), ap + low, bp, high, scratch);
+        table.add_n(rp + low, rp + low, cross.data(), high);
+        mullo(cross.data(), ap, bp + low, high, scratch);
+        table.add_n(rp + low, rp + low, cross.data(), high);
+    }
+
+    /**
+     * @brief Returns the inverse of the odd n-limb array dp modulo 2^(64 n), the multi-limb form of binvert_limb
+     * Each Newton step x = x - x (d x - 1) doubles the number of correct limbs; d x - 1 is zero below the limbs already correct, so only its upper part is multiplied
+     */
+
+    std::vector<limb> binvert(const limb *dp, size_t n)
+    {
+        std::vector<size_t> sizes;
+        for (size_t size = n; size > 1; size = (size + 1) / 2)
+            sizes.push_back(size);
+
+        std::vector<limb> inverse(n), product, scratch;
+        inverse[0] = binvert_limb(dp[0]);
+        size_t known = 1;
+        for (auto size = sizes.rbegin(); size != sizes.rend(); ++size)
+        {
+            // the low limbs of d x are 1, 0, ..., 0 up to limb known, the error h sits in limbs known to size
+            product.resize(*size + known);
+            mul_any(product.data(), dp, *size, inverse.data(), known, scratch);
+            std::vector<limb> error(product.begin() + static_cast<std::ptrdiff_t>(known), product.begin() + static_cast<std::ptrdiff_t>(*size));
+            product.resize(known + error.size());
+            mul_any(product.data(), inverse.data(), known, error.data(), error.size(), scratch);
+            // limbs known to size of the inverse are -(x h) mod 2^(64 (size - known))
+            limb carry = 1;
+            for (size_t i = 0; i < error.size(); ++i)
+            {
+                limb negated = ~product[i] + carry;
+                carry = (negated < carry) ? 1 : 0;
+                inverse[known + i] = negated;
+            }
+            known = *size;
+        }
+        return inverse;
+    }
+
+    constexpr size_t hensel_blockwise_threshold = 96;
+
+    /**
+     * @brief Returns true if the odd dn-limb array dp divides the an-limb array ap (an >= dn, top limb of dp non-zero), the fast version of divisible and divexact for long operands
+     * Works like divisible, but clears a block of limbs at once: the block of quotient limbs is the low limbs of ap times the inverse of dp modulo 2^(64 block), and is subtracted times dp (Montgomery's reduction), so every step is two fast multiplications
+     * With qp null the blocks are dropped once they are subtracted and no quotient is ever built; otherwise the an - dn + 1 quotient limbs of an exact division are written to qp, which must not overlap ap or dp
+     * Blocks of a quarter of dp keep the inverse cheap while the products are still long enough for Karatsuba
+     */
+
+    bool hensel_blockwise(const limb *ap, size_t an, const limb *dp, size_t dn, limb *qp = nullptr)
+    {
+        size_t qn = an - dn + 1;
+        size_t block = std::min({dn, qn, std::max(karatsuba_threshold, dn / 4)});
+        std::vector<limb> inverse = binvert(dp, block);
+        std::vector<limb> remainder(ap, ap + an), quotient((qp == nullptr) ? block : 0), product(block + dn), scratch;
+
+        for (size_t i = 0; i < qn; i += block)
+        {
+            size_t length = std::min(block, qn - i);
+            limb *digits = (qp != nullptr) ? qp + i : quotient.data();
+            mullo(digits, remainder.data() + i, inverse.data(), length, scratch);
+            mul_any(product.data(), digits, length, dp, dn, scratch);
+
+            // the product may reach one limb past ap, which makes ap - q dp negative
+            size_t overlap = std::min(length + dn, an - i);
+            if (overlap < length + dn && product[overlap] != 0)
+                return false;
+            limb borrow = kernels().sub_n(remainder.data() + i, remainder.data() + i, product.data(), overlap);
+            if (sub_borrow(remainder.data() + i + overlap, an - i - overlap, borrow) != 0)
+                return false; // ap - q dp went negative, and it only decreases from here
+        }
+        return std::all_of(remainder.begin() + static_cast<std::ptrdiff_t>(qn), remainder.end(), [](limb x)
+                           { return x == 0; });
+    }
+
+    // ---------------------------------------- shared limb storage ----------------------------------------
+
+    /**
+     * @brief A copy-on-write array of limbs that holds the magnitude of a BigInt object
+     * Copies share one heap block (an atomic reference count and the capacity, followed by the limbs), so copying a BigInt object, negating it or taking its absolute value never copies the limbs
+     * The const members only read the block; every non-const member first makes the block private to this object, copying it if another object still shares it, so the interface works like the one of std::vector<limb>
+     * A block is only written by its sole owner, so objects that share it can be read and copied from different threads
+     */
+
+    class limb_buffer
+    {
+    public:
+        limb_buffer() = default;
+
+        limb_buffer(const limb_buffer &other) noexcept : block(other.block), length(other.length)
+        {
+            if (block != nullptr)
+                block->references.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        limb_buffer(limb_buffer &&other) noexcept : block(std::exchange(other.block, nullptr)), length(std::exchange(other.length, 0)) {}
+
+        limb_buffer &operator=(const limb_buffer &other) noexcept
+        {
+            limb_buffer(other).swap(*this);
+            return *this;
+        }
+
+        limb_buffer &operator=(limb_buffer &&other) noexcept
+        {
+            limb_buffer(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        ~limb_buffer()
+        {
+            release(block);
+        }
+
+        void swap(limb_buffer &other) noexcept
+        {
+            std::swap(block, other.block);
+            std::swap(length, other.length);
+        }
+
+        size_t size() const noexcept
+        {
+            return length;
+        }
+
+        bool empty() const noexcept
+        {
+            return length == 0;
+        }
+
+        /**
+         * @brief Returns true if another object shares the limbs, so the next non-const access copies them
+         */
+
+        bool shared() const noexcept
+        {
+            return block != nullptr && block->references.load(std::memory_order_acquire) > 1;
+        }
+
+        const limb *data() const noexcept
+        {
+            return (block != nullptr) ? block->limbs() : nullptr;
+        }
+
+        const limb *begin() const noexcept
+        {
+            return data();
+        }
+
+        const limb *end() const noexcept
+        {
+            return data() + length;
+        }
+
+        const limb &operator[](size_t index) const noexcept
+        {
+            return data()[index];
+        }
+
+        const limb &back() const noexcept
+        {
+            return data()[length - 1];
+        }
+
+        limb *data()
+        {
+            if (shared())
+                reallocate(length, length);
+            return (block != nullptr) ? block->limbs() : nullptr;
+        }
+
+        limb *begin()
+        {
+            return data();
+        }
+
+        limb *end()
+        {
+            return data() + length;
+        }
+
+        limb &operator[](size_t index)
+        {
+            return data()[index];
+        }
+
+        limb &back()
+        {
+            return data()[length - 1];
+        }
+
+        void reserve(size_t capacity)
+        {
+            own(capacity, length);
+        }
+
+        /**
+         * @brief Changes the number of limbs, new limbs are zero
+         */
+
+        void resize(size_t count)
+        {
+            own(count, count);
+            if (count > length)
+                std::memset(block->limbs() + length, 0, (count - length) * sizeof(limb));
+            length = count;
+        }
+
+        void push_back(limb value)
+        {
+            own(length + 1, length);
+            block->limbs()[length++] = value;
+        }
+
+        void pop_back()
+        {
+            own(length, length);
+            --length;
+        }
+
+        void clear() noexcept
+        {
+            if (shared())
+                release(std::exchange(block, nullptr));
+            length = 0;
+        }
+
+        void assign(size_t count, limb value)
+        {
+            discard(count);
+            std::fill(data(), data() + count, value);
+            length = count;
+        }
+
+        template <typename Iterator>
+        void assign(Iterator first, Iterator last)
+        {
+            size_t count = static_cast<size_t>(std::distance(first, last));
+            discard(count);
+            std::copy(first, last, data());
+            length = count;
+        }
+
+    private:
+        struct header
+        {
+            std::atomic<size_t> references;
+            size_t capacity;
+
+            limb *limbs() noexcept
+            {
+                return reinterpret_cast<limb *>(this + 1);
+            }
+        };
+
+        header *block = nullptr;
+        size_t length = 0; // kept in the object rather than the block, so reading the size does not touch the heap
+
+        static header *allocate(size_t capacity)
+        {
+            note_allocation(sizeof(header) + capacity * sizeof(limb));
+            void *memory = ::operator new(sizeof(header) + capacity * sizeof(limb));
+            return new (memory) header{{1}, capacity};
+        }
+
+        static void release(header *old) noexcept
+        {
+            if (old == nullptr)
+                return;
+            // the sole owner skips the atomic decrement, no other object can take a new reference to the block
+            if (old->references.load(std::memory_order_acquire) == 1 || old->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                old->~header();
+                ::operator delete(old);
+            }
+        }
+
+        /**
+         * @brief Makes the block private to this object with room for capacity limbs, keeping the first keep limbs (at most size())
+         */
+
+        void own(size_t capacity, size_t keep)
+        {
+            if (block != nullptr ? (capacity <= block->capacity && block->references.load(std::memory_order_acquire) == 1) : capacity == 0)
+                return;
+            reallocate(capacity, keep);
+        }
+
+        /**
+         * @brief The slow path of own(): a shared block is copied, and a block that is too small grows to at least twice its capacity, like std::vector does
+         */
+
+        BIGINT_NOINLINE void reallocate(size_t capacity, size_t keep)
+        {
+            size_t old_capacity = (block != nullptr) ? block->capacity : 0;
+            header *fresh = allocate((capacity > old_capacity) ? std::max(capacity, 2 * old_capacity) : capacity);
+            length = std::min(keep, length);
+            if (block != nullptr)
+                std::copy(block->limbs(), block->limbs() + length, fresh->limbs());
+            release(std::exchange(block, fresh));
+        }
+
+        /**
+         * @brief Makes the block private to this object with room for capacity limbs, without keeping the old limbs
+         */
+
+        void discard(size_t capacity)
+        {
+            if (block != nullptr && capacity <= block->capacity && !shared())
+                return;
+            release(std::exchange(block, (capacity != 0) ? allocate(capacity) : nullptr));
+            length = 0;
+        }
+    };
+
+    // ---------------------------------------- decimal limbs ----------------------------------------
+
+    /**
+     * @brief Kernels for magnitudes stored in base 10^19, the largest power of ten below 2^64, used by DecimalBigInt
+     * Every limb holds 19 decimal digits, so converting to and from decimal text is a linear pass, while the arithmetic still works on whole machine words
+     * 10^19 is above 2^63, so it is already a normalized divisor for div_preinv and the sum of two limbs can overflow 64 bits, which add and sub avoid by comparing against the base first
+     */
+
+    namespace decimal
+    {
+        constexpr limb base = 10000000000000000000ULL;
+        constexpr unsigned digits_per_limb = 19;
+        constexpr size_t karatsuba_threshold = 32;
+
+        /**
+         * @brief Returns the reciprocal of the base for div_preinv, computed once
+         */
+
+        inline limb base_reciprocal()
+        {
+            static const limb reciprocal = reciprocal_word(base);
+            return reciprocal;
+        }
+
+        /**
+         * @brief Splits the 128-bit value (high, low) with high < 10^19 into a limb and the carry to the next limb
+         */
+
+        inline limb split(limb high, limb low, limb &digit)
+        {
+            return div_preinv(high, low, base, base_reciprocal(), digit);
+        }
+
+        /**
+         * @brief Adds the an-limb array ap and the bn-limb array bp (an >= bn) in base 10^19, writes the an-limb sum to rp (may be ap) and returns the carry (0 or 1)
+         */
+
+        limb add(limb *rp, const limb *ap, size_t an, const limb *bp, size_t bn)
+        {
+            limb carry = 0;
+            for (size_t i = 0; i < an; ++i)
+            {
+                limb b = (i < bn) ? bp[i] : 0;
+                if (i >= bn && carry == 0 && rp == ap)
+                    return 0;
+                limb room = base - b - carry; // at least 0, since b < base
+                if (ap[i] >= room)
+                {
+                    rp[i] = ap[i] - room;
+                    carry = 1;
+                }
+                else
+                {
+                    rp[i] = ap[i] + b + carry;
+                    carry = 0;
+                }
+            }
+            return carry;
+        }
+
+        /**
+         * @brief Subtracts the bn-limb array bp from the an-limb array ap (an >= bn) in base 10^19, writes the an-limb difference to rp (may be ap) and returns the borrow (0 or 1)
+         */
+
+        limb sub(limb *rp, const limb *ap, size_t an, const limb *bp, size_t bn)
+        {
+            limb borrow = 0;
+            for (size_t i = 0; i < an; ++i)
+            {
+                limb b = (i < bn) ? bp[i] : 0;
+                if (i >= bn && borrow == 0 && rp == ap)
+                    return 0;
+                limb taken = b + borrow; // at most base
+                if (ap[i] >= taken)
+                {
+                    rp[i] = ap[i] - taken;
+                    borrow = 0;
+                }
+                else
+                {
+                    rp[i] = ap[i] + (base - taken);
+                    borrow = 1;
+                }
+            }
+            return borrow;
+        }
+
+        /**
+         * @brief Multiplies the an-limb array ap by the bn-limb array bp in base 10^19 with the schoolbook method and writes the (an + bn)-limb product to rp
+         * Each step a b + r + carry is below 10^38 + 2 10^19, so its high limb stays below the base and div_preinv splits it without a division instruction
+         */
+
+        void mul_basecase(limb *rp, const limb *ap, size_t an, const limb *bp, size_t bn)
+        {
+            std::fill(rp, rp + an + bn, 0);
+            for (size_t j = 0; j < bn; ++j)
+            {
+                limb carry = 0;
+                for (size_t i = 0; i < an; ++i)
+                {
+                    limb high;
+                    limb low = mul_wide(ap[i], bp[j], high);
+                    low += rp[i + j];
+                    high += (low < rp[i + j]) ? 1 : 0;
+                    low += carry;
+                    high += (low < carry) ? 1 : 0;
+                    carry = split(high, low, rp[i + j]);
+                }
+                rp[an + j] = carry;
+            }
+        }
+
+        /**
+         * @brief Multiplies the an-limb array ap by the bn-limb array bp (an >= bn >= 1) in base 10^19 and writes the (an + bn)-limb product to rp
+         * Uses Karatsuba's method on balanced operands like bigint_detail::mul, and cuts unbalanced ones into balanced pieces
+         */
+
+        void mul(limb *rp, const limb *ap, size_t an, const limb *bp, size_t bn)
+        {
+            if (bn < karatsuba_threshold)
+            {
+                mul_basecase(rp, ap, an, bp, bn);
+                return;
+            }
+
+            if (bn <= (an + 1) / 2)
+            {
+                std::fill(rp, rp + an + bn, 0);
+                std::vector<limb> product(2 * bn);
+                for (size_t offset = 0; offset < an; offset += bn)
+                {
+                    size_t length = std::min(bn, an - offset);
+                    if (length >= bn)
+                        mul(product.data(), ap + offset, length, bp, bn);
+                    else
+                        mul(product.data(), bp, bn, ap + offset, length);
+                    add(rp + offset, rp + offset, an + bn - offset, product.data(), length + bn);
+                }
+                return;
+            }
+
+            size_t half = (an + 1) / 2;
+            size_t a_high = an - half, b_high = bn - half;
+            std::vector<limb> a_sum(half + 1), b_sum(half + 1);
+            a_sum[half] = add(a_sum.data(), ap, half, ap + half, a_high);
+            b_sum[half] = add(b_sum.data(), bp, half, bp + half, b_high);
+            size_t a_sum_size = half + (a_sum[half] != 0 ? 1 : 0);
+            size_t b_sum_size = half + (b_sum[half] != 0 ? 1 : 0);
+
+            std::vector<limb> middle(a_sum_size + b_sum_size);
+            mul(rp, ap, half, bp, half);
+            mul(rp + 2 * half, ap + half, a_high, bp + half, b_high);
+            if (a_sum_size >= b_sum_size)
+                mul(middle.data(), a_sum.data(), a_sum_size, b_sum.data(), b_sum_size);
+            else
+                mul(middle.data(), b_sum.data(), b_sum_size, a_sum.data(), a_sum_size);
+
+            size_t middle_size = middle.size();
+            sub(middle.data(), middle.data(), middle_size, rp, 2 * half);
+            sub(middle.data(), middle.data(), middle_size, rp + 2 * half, a_high + b_high);
+            while (middle_size > 0 && middle[middle_size - 1] == 0)
+                --middle_size;
+            add(rp + half, rp + half, an + bn - half, middle.data(), middle_size);
+        }
+
+        /**
+         * @brief Divides the n-limb array ap by d (0 < d < 10^19) in base 10^19, writes the n-limb quotient to qp (may be ap) and returns the remainder
+         */
+
+        limb divrem_1(limb *qp, const limb *ap, size_t n, limb d)
+        {
+            limb remainder = 0;
+            for (size_t i = n; i > 0; --i)
+            {
+                limb high;
+                limb low = mul_wide(remainder, base, high); // remainder * base + a_i < d * base, so the quotient fits in a limb
+                low += ap[i - 1];
+                high += (low < ap[i - 1]) ? 1 : 0;
+                qp[i - 1] = div_wide(high, low, d, remainder);
+            }
+            return remainder;
+        }
+    }
+}
+
+/**
+ * @brief The low-level layer of BigInt: raw limb arithmetic over spans, in the style of the mpn functions of GMP
+ * A number is a span of 64-bit limbs in little-endian order, the caller owns every buffer and nothing is allocated except by the parallel mode of mul and sqr
+ * Destinations are written in full and have the exact sizes given below, so a loop can reuse the same buffers for every iteration
+ * The functions that need temporary space take a scratch span whose size is given by the matching *_scratch_size function
+ * Sizes are checked and a std::invalid_argument exception is thrown on misuse; a destination may be exactly a source only where it is stated
+ */
+
+namespace bigint_mpn
+{
+    using limb = bigint_detail::limb;
+
+    /**
+     * @brief Throws std::invalid_argument with the given message if the condition does not hold
+     */
+
+    inline void require(bool condition, const char *message)
+    {
+        if (!condition)
+            throw std::invalid_argument(message);
+    }
+
+    /**
+     * @brief Adds the equal-size spans a and b into result (same size, may be a or b) and returns the carry (0 or 1)
+     */
+
+    limb add_n(std::span<limb> result, std::span<const limb> a, std::span<const limb> b)
+    {
+        require(a.size() == b.size() && result.size() == a.size(), "bigint_mpn::add_n: the spans must have the same size");
+        if (a.empty())
+            return 0;
+        return bigint_detail::kernels().add_n(result.data(), a.data(), b.data(), a.size());
+    }
+
+    /**
+     * @brief Subtracts the span b from the equal-size span a into result (same size, may be a or b) and returns the borrow (0 or 1)
+     */
+
+    limb sub_n(std::span<limb> result, std::span<const limb> a, std::span<const limb> b)
+    {
+        require(a.size() == b.size() && result.size() == a.size(), "bigint_mpn::sub_n: the spans must have the same size");
+        if (a.empty())
+            return 0;
+        return bigint_detail::kernels().sub_n(result.data(), a.data(), b.data(), a.size());
+    }
+
+    /**
+     * @brief Adds the span b to the span a (a.size() >= b.size()) into result of a.size() limbs (may be a) and returns the carry (0 or 1)
+     */
+
+    limb add(std::span<limb> result, std::span<const limb> a, std::span<const limb> b)
+    {
+        require(a.size() >= b.size() && result.size() == a.size(), "bigint_mpn::add: a must be at least as long as b and result as long as a");
+        return bigint_detail::add(result.data(), a.data(), a.size(), b.data(), b.size());
+    }
+
+    /**
+     * @brief Subtracts the span b from the span a (a.size() >= b.size()) into result of a.size() limbs (may be a) and returns the borrow (0 or 1)
+     */
+
+    limb sub(std::span<limb> result, std::span<const limb> a, std::span<const limb> b)
+    {
+        require(a.size() >= b.size() && result.size() == a.size(), "bigint_mpn::sub: a must be at least as long as b and result as long as a");
+        return bigint_detail::sub(result.data(), a.data(), a.size(), b.data(), b.size());
+    }
+
+    /**
+     * @brief Multiplies the span a by the limb b into result (same size, may be a) and returns the high limb of the product
+     */
+
+    limb mul_1(std::span<limb> result, std::span<const limb> a, limb b)
+    {
+        require(result.size() == a.size(), "bigint_mpn::mul_1: result must have the size of a");
+        if (a.empty())
+            return 0;
+        return bigint_detail::kernels().mul_1(result.data(), a.data(), a.size(), b);
+    }
+
+    /**
+     * @brief Adds the product of the span a and the limb b to result (same size) and returns the carry limb
+     */
+
+    limb addmul_1(std::span<limb> result, std::span<const limb> a, limb b)
+    {
+        require(result.size() == a.size(), "bigint_mpn::addmul_1: result must have the size of a");
+        if (a.empty())
+            return 0;
+        return bigint_detail::kernels().addmul_1(result.data(), a.data(), a.size(), b);
+    }
+
+    /**
+     * @brief Subtracts the product of the span a and the limb b from result (same size) and returns the borrow limb
+     */
+
+    limb submul_1(std::span<limb> result, std::span<const limb> a, limb b)
+    {
+        require(result.size() == a.size(), "bigint_mpn::submul_1: result must have the size of a");
+        if (a.empty())
+            return 0;
+        return bigint_detail::kernels().submul_1(result.data(), a.data(), a.size(), b);
+    }
+
+    /**
+     * @brief Shifts the non-empty span a left by count bits (0 < count < 64) into result (same size, may be a) and returns the bits shifted out
+     */
+
+    limb lshift(std::span<limb> result, std::span<const limb> a, unsigned count)
+    {
+        require(!a.empty() && result.size() == a.size(), "bigint_mpn::lshift: result must have the size of a non-empty span");
+        require(count > 0 && count < 64, "bigint_mpn::lshift: the count must be between 1 and 63");
+        return bigint_detail::lshift(result.data(), a.data(), a.size(), count);
+    }
+
+    /**
+     * @brief Shifts the non-empty span a right by count bits (0 < count < 64) into result (same size, may be a) and returns the bits shifted out in the high bits of a limb
+     */
+
+    limb rshift(std::span<limb> result, std::span<const limb> a, unsigned count)
+    {
+        require(!a.empty() && result.size() == a.size(), "bigint_mpn::rshift: result must have the size of a non-empty span");
+        require(count > 0 && count < 64, "bigint_mpn::rshift: the count must be between 1 and 63");
+        return bigint_detail::rshift(result.data(), a.data(), a.size(), count);
+    }
+
+    /**
+     * @brief Compares the spans a and b as numbers (high zero limbs are allowed) and returns -1, 0 or 1
+     */
+
+    int compare(std::span<const limb> a, std::span<const limb> b)
+    {
+        size_t a_size = a.size(), b_size = b.size();
+        while (a_size > 0 && a[a_size - 1] == 0)
+            --a_size;
+        while (b_size > 0 && b[b_size - 1] == 0)
+            --b_size;
+        if (a_size != b_size)
+            return (a_size < b_size) ? -1 : 1;
+        for (size_t i = a_size; i > 0; --i)
+            if (a[i - 1] != b[i - 1])
+                return (a[i - 1] < b[i - 1]) ? -1 : 1;
+        return 0;
+    }
+
+    /**
+     * @brief Returns the size of the span a without its high zero limbs
+     */
+
+    size_t normalized_size(std::span<const limb> a)
+    {
+        size_t size = a.size();
+        while (size > 0 && a[size - 1] == 0)
+            --size;
+        return size;
+    }
+
+    /**
+     * @brief Returns the number of scratch limbs that mul needs for spans of a_size and b_size limbs (in any order)
+     */
+
+    size_t mul_scratch_size(size_t a_size, size_t b_size)
+    {
+        return bigint_detail::mul_scratch_size(std::max(a_size, b_size), std::min(a_size, b_size));
+    }
+
+    /**
+     * @brief Multiplies the non-empty spans a and b into result of a.size() + b.size() limbs
+     * result must not overlap a, b or the scratch, which holds at least mul_scratch_size(a.size(), b.size()) limbs
+     */
+
+    void mul(std::span<limb> result, std::span<const limb> a, std::span<const limb> b, std::span<limb> scratch)
+    {
+        require(!a.empty() && !b.empty(), "bigint_mpn::mul: the operands must not be empty");
+        require(result.size() == a.size() + b.size(), "bigint_mpn::mul: result must have the size of a plus the size of b");
+        require(scratch.size() >= mul_scratch_size(a.size(), b.size()), "bigint_mpn::mul: the scratch is smaller than mul_scratch_size");
+        if (a.size() < b.size())
+            std::swap(a, b);
+        bigint_detail::mul(result.data(), a.data(), a.size(), b.data(), b.size(), scratch.data());
+    }
+
+    /**
+     * @brief Returns the number of scratch limbs that sqr needs for a span of size limbs
+     */
+
+    size_t sqr_scratch_size(size_t size)
+    {
+        return bigint_detail::mul_scratch_size(size, size);
+    }
+
+    /**
+     * @brief Squares the non-empty span a into result of 2 a.size() limbs, which is faster than mul(result, a, a, scratch)
+     * result must not overlap a or the scratch, which holds at least sqr_scratch_size(a.size()) limbs
+     */
+
+    void sqr(std::span<limb> result, std::span<const limb> a, std::span<limb> scratch)
+    {
+        require(!a.empty(), "bigint_mpn::sqr: the operand must not be empty");
+        require(result.size() == 2 * a.size(), "bigint_mpn::sqr: result must have twice the size of a");
+        require(scratch.size() >= sqr_scratch_size(a.size()), "bigint_mpn::sqr: the scratch is smaller than sqr_scratch_size");
+        bigint_detail::sqr(result.data(), a.data(), a.size(), scratch.data());
+    }
+
+    /**
+     * @brief Divides the span a by the limb d (non-zero) into quotient (same size, may be a) and returns the remainder
+     */
+
+    limb divrem_1(std::span<limb> quotient, std::span<const limb> a, limb d)
+    {
+        require(d != 0, "bigint_mpn::divrem_1: division by zero");
+        require(quotient.size() == a.size(), "bigint_mpn::divrem_1: quotient must have the size of a");
+        return bigint_detail::divrem_1(quotient.data(), a.data(), a.size(), d);
+    }
+
+    /**
+     * @brief Returns the number of scratch limbs that divrem needs for a dividend of a_size limbs and a divisor of d_size limbs
+     */
+
+    size_t divrem_scratch_size(size_t a_size, size_t d_size)
+    {
+        return (d_size < 2) ? 0 : a_size + 1 + d_size;
+    }
+
+    /**
+     * @brief Divides the span a by the span d (a.size() >= d.size(), top limb of d non-zero) into quotient of a.size() - d.size() + 1 limbs and remainder of d.size() limbs
+     * The outputs must not overlap the inputs or the scratch, which holds at least divrem_scratch_size(a.size(), d.size()) limbs
+     */
+
+    void divrem(std::span<limb> quotient, std::span<limb> remainder, std::span<const limb> a, std::span<const limb> d, std::span<limb> scratch)
+    {
+        require(!d.empty() && d.back() != 0, "bigint_mpn::divrem: the top limb of the divisor must not be zero");
+        require(a.size() >= d.size(), "bigint_mpn::divrem: the dividend must be at least as long as the divisor");
+        require(quotient.size() == a.size() - d.size() + 1 && remainder.size() == d.size(), "bigint_mpn::divrem: wrong quotient or remainder size");
+        require(scratch.size() >= divrem_scratch_size(a.size(), d.size()), "bigint_mpn::divrem: the scratch is smaller than divrem_scratch_size");
+        if (d.size() == 1)
+            remainder[0] = bigint_detail::divrem_1(quotient.data(), a.data(), a.size(), d[0]);
+        else
+            bigint_detail::divrem(quotient.data(), remainder.data(), a.data(), a.size(), d.data(), d.size(), scratch.data());
+    }
+}
+
+class BigIntView;
+
+/**
+ * @brief A class for arbitrary-precision integer
+ */
+
+class BigInt
+{
+
+public:
+    /**
+     * @brief The Default constructor which Construct a new BigInt object and initialize it to zero
+     */
+
+    BigInt();
+
+    /**
+     * @brief The constructor that takes a signed 64-bit integer and Construct a new BigInt object
+     *
+     * @param int_number The signed 64-bit integer
+     */
+
+    BigInt(const int64_t int_number);
+
+    /**
+     * @brief The constructor that takes a string of digits and construct a new BigInt object
+     * Since a string input may have a bad format with leading zeros and spaces or contain invalid digits
+     * Then before finalizing the construction, the input need to be trimmed and validated to ensure it represents a valid and well-formatted input for the rest of process
+     *
+     * @param str_number The string representing the integer
+     */
+
+    BigInt(const std::string &str_number);
+
+    /**
+     * @brief The constructor that copies the value of a read-only BigIntView into a new BigInt object
+     * This is the only place where the limbs of a view are copied, arithmetic and comparisons read views directly
+     *
+     * @param view The view to copy
+     */
+
+    explicit BigInt(const BigIntView &view);
+
+    /**
+     * @brief The constructor that takes a string of digits in any base from 2 to 36 and constructs a new BigInt object
+     * The digits are 0-9 followed by the letters a-z (or A-Z), leading spaces, a sign and leading zeros are allowed
+     * Power-of-two bases are converted by placing the bits of every digit directly, other bases by the same divide-and-conquer conversion as base 10
+     *
+     * @param str_number The digits of the number, for example "-ff" in base 16
+     * @param base The base of the digits, an exception is thrown if it is not between 2 and 36
+     */
+
+    BigInt(const std::string &str_number, unsigned base);
+
+    /**
+     * @brief The member function which returns the sign of a BigInt object
+     * Used to access the 'sign' which is private member of the BigInt class, and read the sign of an object
+     *
+     * @return A character representing the sign of a BigInt object ('+' or '-')
+     */
+
+    char getsign() const;
+
+    /**
+     * @brief The member function that receives and sets the sign of a new BigInt object
+     * Used to set the sign for a newly created BigInt object resulting from operations like *, + , - , / and %
+     *
+     * @param ch A character representing the new sign ('+' or '-')
+     */
+
+    void setsign(char ch);
+
+    /**
+     * @brief The member function that returns the numerical part of a BigInt object
+     * Converts the binary magnitude to decimal by repeatedly dividing it by 10^19, and returns the numerical value without the sign
+     *
+     * @return A string representing the numerical part of a BigInt object
+     */
+
+    std::string getnumber() const;
+
+    /**
+     * @brief The member function that receives and sets the numerical part of a new BigInt object
+     * Used to set the numerical part for a newly created BigInt object resulting from operations like *, +, - , / and %
+     * This function remove leading zeros before converting the decimal digits to the binary magnitude, and throws an exception if the string contains anything other than digits
+     *
+     * @param str A string representing the new numerical value
+     */
+
+    void setnumber(const std::string &str);
+
+    /**
+     * @brief The member function that returns number of decimal digits in the numerical part of a BigInt object
+     * Values that fit in one limb are counted directly, larger values are estimated from the bit length and the top two limbs, without any conversion to decimal
+     *
+     * @return size_t The number of digits in the numerical part of a BigInt object
+     */
+
+    size_t getsize() const;
+
+    /**
+     * @brief Returns the digits of a BigInt object in any base from 2 to 36, with lowercase letters and a '-' in front of negative numbers
+     * Power-of-two bases take one pass over the bits, other bases split the number by precomputed powers of the base in divide-and-conquer fashion
+     *
+     * @param base The base of the digits, an exception is thrown if it is not between 2 and 36
+     * @return std::string The digits, for example "-ff" for -255 in base 16
+     */
+
+    std::string to_string(unsigned base = 10) const;
+
+    /**
+     * @brief Returns the value of a BigInt object as a signed 64-bit integer, reading at most one limb
+     * Throws std::out_of_range if the value does not fit, fits_in<int64_t>() checks that without an exception
+     *
+     * @return int64_t The value of the current BigInt (*this)
+     */
+
+    int64_t to_int64() const;
+
+    /**
+     * @brief Returns the value of a BigInt object as an unsigned 64-bit integer, reading at most one limb
+     * Throws std::out_of_range if the value is negative or does not fit
+     *
+     * @return uint64_t The value of the current BigInt (*this)
+     */
+
+    uint64_t to_uint64() const;
+
+    /**
+     * @brief Returns the value of a BigInt object correctly rounded to the nearest double (ties to even)
+     * Only the top two or three limbs are read, the lower limbs only when the value is exactly halfway between two doubles
+     * Values beyond the range of double return an infinity with the sign of the BigInt object
+     *
+     * @return double The rounded value of the current BigInt (*this)
+     */
+
+    double to_double() const;
+
+    /**
+     * @brief Returns the value of a BigInt object correctly rounded to the nearest long double (ties to even), like to_double()
+     *
+     * @return long double The rounded value of the current BigInt (*this)
+     */
+
+    long double to_long_double() const;
+
+    /**
+     * @brief Splits a BigInt object like std::frexp into a mantissa in [0.5, 1) and a binary exponent, so value ~ mantissa * 2^exponent
+     * The mantissa is correctly rounded to double precision and never overflows, so it can rank numbers far beyond the range of double
+     *
+     * @param exponent Receives the binary exponent (0 for zero)
+     * @return double The mantissa with the sign of the BigInt object (0 for zero)
+     */
+
+    double frexp(int64_t &exponent) const;
+
+    /**
+     * @brief Checks whether the value of a BigInt object can be converted to the arithmetic type T without overflow
+     * For integer types the value must be in [min, max] of T, for floating-point types the rounded value must be finite
+     *
+     * @tparam T An integer or floating-point type, for example int32_t, uint64_t or double
+     * @return bool Whether the value fits in T
+     */
+
+    template <typename T>
+    bool fits_in() const;
+
+    /**
+     * @brief The member function that returns the absolute value of a BigInt object
+     * The result shares the limbs of (*this), so it takes constant time whatever the size
+     *
+     * @return BigInt the absolute value of the current BigInt (*this)
+     */
+
+    BigInt abs() const;
+
+    /**
+     * @brief Overloads the addition operator (+) for BigInt class
+     * Performs addition between the current BigInt object (*this) and  operand
+     * The process is split into different scenarios based on the signs and sizes of the objects: equal signs add the magnitudes, different signs subtract the smaller magnitude from the larger one
+     * The magnitudes are added limb by limb with the add_n and sub_n kernels, similar to the traditional school method in base 2^64
+     *
+     * @param operand The BigInt object to be added to *this
+     * @return BigInt a new BigInt object representing the sum of the two BigInt objects
+     */
+
+    BigInt operator+(const BigInt &operand) const;
+
+    /**
+     * @brief Overloads the compound addition operator (+=) for BigInt class
+     * Performs addition between the current BigInt object (*this) and operand in place, without copying *this
+     * This process add operand to *this and update the value of *this
+     *
+     * @param operand The BigInt object to be added to (*this)
+     * @return BigInt& A reference to the updated BigInt object (*this)
+     */
+
+    BigInt &operator+=(const BigInt &operand);
+
+    /**
+     * @brief Overloads the subtraction operator (-) for BigInt class
+     * Performs subtraction between the current BigInt object (*this) and operand
+     * This operation takes advantage of the logic of the overloaded addition '+' with the sign of the operand flipped, so the operand is not copied
+     *
+     * @param operand The BigInt object to subtract from *this
+     * @return BigInt a new BigInt object representing the subtraction of the two BigInt objects
+     */
+
+    BigInt operator-(const BigInt &operand) const;
+
+    /**
+     * @brief Overloads the compound subtraction (-=) operator for BigInt class
+     * Performs subtraction between the current BigInt object (*this) and operand in place, without copying *this
+     * this process subtract operand from *this and update the value of *this
+     *
+     * @param operand The BigInt object to subtract from *this
+     * @return BigInt& A reference to the updated BigInt object (*this)
+     */
+
+    BigInt &operator-=(const BigInt &operand);
+
+    /**
+     * @brief Overloads the multiplication operator (*) for BigInt class
+     * Performs multiplication between the current BigInt object (*this) and the operand
+     * Short operands are multiplied limb-by-limb, similar to traditional school multiplication in base 2^64, with each row accumulated by the addmul_1 kernel
+     * Longer operands use Karatsuba's method, which replaces four half-size products by three, and unbalanced operands are cut into balanced pieces
+     * When the parallel mode is on (see setthreads()) the independent subproducts of large operands run on several threads
+     *
+     * @param operand The BigInt object to multiply with *this
+     * @return BigInt a new BigInt object representing the multiplication of the two BigInt objects
+     */
+
+    BigInt operator*(const BigInt &operand) const;
+
+    /**
+     * @brief Overloads the compound multiplication (*=) operator for BigInt class
+     * Uses the logic of the overloaded operator `*` to perform multiplication between the current BigInt object (*this) and operand
+     * This process multiplies the operand with (*this) and updates the value of (*this)
+     *
+     * @param operand The BigInt object to multiply with *this
+     * @return BigInt& A reference to the updated BigInt object (*this)
+     */
+
+    BigInt &operator*=(const BigInt &operand);
+
+    /**
+     * @brief Sets the number of threads used by one multiplication, which turns the parallel mode on or off for all BigInt objects
+     * With more than one thread, the independent subproducts of Karatsuba and of unbalanced multiplications run on a work-stealing thread pool
+     * Must not be called while other threads are computing with BigInt objects
+     *
+     * @param thread_count The total number of threads including the calling one, 1 (the default) means serial and 0 means one thread per hardware thread
+     */
+
+    static void setthreads(unsigned thread_count);
+
+    /**
+     * @brief Returns the number of threads used by one multiplication
+     *
+     * @return unsigned The total number of threads, 1 when the parallel mode is off
+     */
+
+    static unsigned getthreads();
+
+    /**
+     * @brief Sets the grain size of the parallel mode, below which multiplications stay serial because splitting them costs more than it saves
+     *
+     * @param limbs The size in 64-bit limbs of the shorter operand below which a product is never split across threads
+     */
+
+    static void setgrainsize(size_t limbs);
+
+    /**
+     * @brief Returns the grain size of the parallel mode in 64-bit limbs
+     *
+     * @return size_t The size of the shorter operand below which a product is never split across threads
+     */
+
+    static size_t getgrainsize();
+
+    /**
+     * @brief Returns a snapshot of the instrumentation counters: calls per operation and size bucket, calls per algorithm tier, time and bytes allocated
+     * The counters only move when BIGINT_INSTRUMENTATION is defined before including this header, otherwise the instrumentation costs nothing and the snapshot is zero
+     *
+     * @return BigIntStats The counters since the start of the program or the last resetstats()
+     */
+
+    static BigIntStats getstats();
+
+    /**
+     * @brief Sets every instrumentation counter back to zero
+     */
+
+    static void resetstats();
+
+    /**
+     * @brief Registers a function that is called with a BigIntEvent after every counted operation, on the thread that ran it, or removes it when hook is empty
+     * The hook must not throw, operations it makes are counted but do not call it again, and it must not be changed while other threads are computing with BigInt objects
+     *
+     * @param hook The function to call, for example one that feeds a histogram or logs the slow operations
+     */
+
+    static void setstatshook(std::function<void(const BigIntEvent &)> hook);
+
+    /**
+     * @brief Overloads the unary negation operator (-) for BigInt class
+     * Changes the sign of the BigInt object from '+' to '-' and vice versa and returns a new BigInt object with the opposite sign, zero stays positive
+     * The result shares the limbs of (*this), so it takes constant time whatever the size
+     *
+     * @return BigInt a new BigInt object with the opposite sign
+     */
+
+    BigInt operator-() const;
+
+    /**
+     * @brief Overloads the division operator (/) for BigInt class
+     * Performs division of the current BigInt object (*this) as the dividend and the operand as the divisor
+     * The quotient is truncated toward zero. A single-limb divisor uses the divrem_1 kernel, and longer divisors use Knuth's long division (algorithm D), which estimates one quotient limb at a time
+     *
+     * @param operand The BigInt object as the divisor
+     * @return BigInt A BigInt representing the quotient of the division
+     */
+
+    BigInt operator/(const BigInt &operand) const;
+
+    /**
+     * @brief Overloads the compound division operator (/=) for BigInt class
+     * Uses the logic of the overloaded operator `/`  to divide the current BigInt object (*this) by the operand as divisor
+     * Updates *this with the quotient and returns the updated *this
+     *
+     * @param operand The BigInt object as the divisor
+     * @return BigInt& A reference to the updated object (*this)
+     */
+
+    BigInt &operator/=(const BigInt &operand);
+
+    /**
+     * @brief Overloads the modulus operator (%) for BigInt class
+     * Uses the same long division as the operator `/` to calculate the remainder of the magnitudes, which is then adjusted so the modulus is always non-negative
+     *
+     * @param operand The BigInt object as the divisor
+     * @return BigInt a new BigInt object representing the remainder of the division
+     */
+
+    BigInt operator%(const BigInt &operand) const;
+
+    /**
+     * @brief Overloads the compound modulus operator (%=) for BigInt class
+     * Uses the logic of the overloaded operator `%` to calculate the remainder of the division of the current BigInt object (*this) by the operand and return updated *this
+     *
+     * @param operand The BigInt object as the divisor
+     * @return BigInt&  A reference to the updated BigInt object (*this)
+     */
+
+    BigInt &operator%=(const BigInt &operand);
+
+    /**
+     * @brief Overloads the equality (==) operator for BigInt class
+     * Compare the current BigInt object (*this) and operand to determine whether they are equal or not
+     * First Compares the sizes and signs of both BigInt objects ,If the sizes and signs are equal, performs a limb-by-limb comparison of their magnitudes in place
+     *
+     * @param operand The BigInt object to compare with (*this)
+     * @return true if the two BigInt objects are equal
+     * @return false if the two BigInt objects are not equal
+     */
+
+    bool operator==(const BigInt &operand) const;
+
+    /**
+     * @brief Overloads the inequality operator (!=) for BigInt class
+     * uses the logic of the equality operator (`==`) and Compares the current BigInt object (*this) with the operand for inequality
+     *
+     * @param operand The BigInt object to compare with *this
+     * @return true if the two BigInt objects are not equal
+     * @return false if the two BigInt objects are equal
+     */
+
+    bool operator!=(const BigInt &operand) const;
+
+    /**
+     * @brief Overloads the three-way comparison operator (<=>) for BigInt class
+     * Compares the current BigInt object (*this) with the operand in a single pass, without copying the numerical parts
+     * First compares the signs, then the number of limbs, and only if both are equal compares the limbs starting from the most significant one
+     * Zero is treated as unsigned, so "+0" and "-0" compare equal
+     *
+     * @param operand The BigInt object to compare with *this
+     * @return std::strong_ordering less, equal or greater depending on the order of (*this) and the operand
+     */
+
+    std::strong_ordering operator<=>(const BigInt &operand) const;
+
+    /**
+     * @brief Overloads the greater-than operator (>) for BigInt class
+     * Uses the logic of the overloaded operator `<=>` to determine whether *this is greater than the operand or not
+     *
+     * @param operand The BigInt object to compare with *this
+     * @return true if (*this) is greater than the operand
+     * @return false if (*this) is not greater than the operand
+     */
+
+    bool operator>(const BigInt &operand) const;
+
+    /**
+     * @brief Overloads the less-than operator (<) for BigInt class
+     * Uses the logic of the overloaded operator `<=>` to determine whether (*this) is less than the operand or not
+     *
+     * @param operand The BigInt object to compare with *this
+     * @return true if (*this) is less than the operand
+     * @return false if (*this) is not less than the operand
+     */
+
+    bool operator<(const BigInt &operand) const;
+
+    /**
+     * @brief Overloads the greater-than-or-equal-to operator (>=) for BigInt class
+     * Uses the logic of the overloaded operator `<=>` to determine whether *this is greater than or equal to the operand with a single comparison
+     *
+     * @param operand The BigInt object to compare with *this
+     * @return true if (*this) is greater than or equal to the operand
+     * @return false if (*this) is not greater than or equal to the operand
+     */
+
+    bool operator>=(const BigInt &operand) const;
+
+    /**
+     * @brief Overloads the less-than-or-equal-to operator (<=) for BigInt class
+     * Uses the logic of the overloaded operator `<=>` to determine whether (*this) is less than or equal to the operand with a single comparison
+     *
+     * @param operand The BigInt object to compare with (*this)
+     * @return true  if (*this) is less than or equal to the operand
+     * @return false if (*this) is not less than or equal to the operand
+     */
+
+    bool operator<=(const BigInt &operand) const;
+
+    /**
+     * @brief Overloads the pre-increment operator (++X) for BigInt class
+     * Uses the logic of the overloaded operator `+=` to increment the current BigInt object (*this) by 1 in place
+     * the function returns the incremented value of *this
+     *
+     * @return BigInt& A reference to the updated BigInt object (*this)
+     */
+
+    BigInt &operator++();
+
+    /**
+     * @brief Overloads the post-increment operator (X++) for BigInt class
+     * The function creates a copy of (*this) and increments (*this) by 1 using the logic of the overloaded operator '+'
+     * the function returns the original (pre-increment) value of (*this)
+     *
+     *@param int  is a parameter to differentiate post-increment from pre-increment
+     * @return BigInt  a BigInt object representing the original value of (*this)
+     */
+
+    BigInt operator++(int);
+
+    /**
+     * @brief Overloads the pre-decrement operator (--X) for BigInt class
+     * Uses the logic of the overloaded operator `-=` to decrement the current BigInt object (*this) by 1 in place
+     * the function returns the decremented value of *this
+     *
+     * @return BigInt& A reference to the updated BigInt object (*this)
+     */
+
+    BigInt &operator--();
+
+    /**
+     * @brief Overloads the post-decrement operator (X--) for BigInt class
+     * The function creates a copy of (*this) and decrements (*this) by 1 using the logic of the overloaded operator  `-`
+     * the function returns the original (pre-decrement) value of (*this)
+     *
+     * @param int is a parameter to differentiate post-decrement from pre-decrement
+     * @return BigInt a BigInt object representing the original value of (*this)
+     */
+
+    BigInt operator--(int);
+
+    /**
+     * @brief Overloads the insertion operator (<<) for BigInt class
+     * Streams a BigInt object to an output stream, formatting it with the sign ('+' or '-') followed by its numerical part
+     *
+     * @param out The output stream that the BigInt object will be written to
+     * @param bigint The BigInt object to be output
+     * @return std::ostream& A reference to the modified output stream
+     */
+
+    friend std::ostream &operator<<(std::ostream &out, const BigInt &bigint);
+
+    /**
+     * @brief Overloads the extraction operator (>>) for BigInt class
+     * Skips leading whitespace, reads an optional sign and then digits until the first character that is not a digit, which is left in the stream
+     * The digits are converted in blocks as they arrive and combined in divide-and-conquer fashion, so the decimal text is never held in memory as a whole
+     * If no digit follows, the failbit is set and the BigInt object is left unchanged
+     *
+     * @param in The input stream that the BigInt object will be read from
+     * @param bigint The BigInt object that receives the value
+     * @return std::istream& A reference to the modified input stream
+     */
+
+    friend std::istream &operator>>(std::istream &in, BigInt &bigint);
+
+#if defined(BIGINT_HAS_FD_INPUT)
+    /**
+     * @brief Reads a BigInt object from a file descriptor that holds one decimal number, for example a file of hundreds of megabytes of digits
+     * The file is read in 64 KiB pieces and converted like the operator `>>` does, leading and trailing whitespace is allowed
+     * Throws std::invalid_argument if the content is not a valid number and std::system_error if reading fails
+     *
+     * @param fd An open file descriptor, read until the end of the file and not closed
+     * @return BigInt The number in the file
+     */
+
+    static BigInt from_fd(int fd);
+#endif
+
+    /**
+     * @brief The member function that returns a hash value of a BigInt object
+     * Used by the std::hash<BigInt> specialization so BigInt objects can be used as keys of std::unordered_map and std::unordered_set
+     * The limbs are hashed in place and mixed with the sign, and zero hashes the same regardless of its sign to stay consistent with `==`
+     *
+     * @return size_t The hash value of the current BigInt (*this)
+     */
+
+    size_t hash() const;
+
+    /**
+     * @brief Returns the number of bytes of the binary form of a BigInt object written by serialize()
+     * The binary form is a 16-byte header (the magic "BIGN", a version byte, a sign byte, two zero bytes and the limb count as a little-endian 64-bit integer) followed by the limbs as little-endian 64-bit integers
+     *
+     * @return size_t 16 + 8 * (number of limbs)
+     */
+
+    size_t serialized_size() const;
+
+    /**
+     * @brief Writes the binary form of a BigInt object into a buffer provided by the caller
+     * The limbs are copied as they are, so the cost is a single memory copy and no radix conversion
+     *
+     * @param buffer The destination, at least serialized_size() bytes, an exception is thrown if it is too small
+     */
+
+    void serialize(std::span<std::byte> buffer) const;
+
+    /**
+     * @brief Returns the binary form of a BigInt object in a new byte array
+     *
+     * @return std::vector<std::byte> The serialized_size() bytes of the binary form
+     */
+
+    std::vector<std::byte> serialize() const;
+
+    /**
+     * @brief Writes the binary form of a BigInt object to an output stream, for example a checkpoint file opened in binary mode
+     *
+     * @param out The output stream that receives the binary form
+     */
+
+    void serialize(std::ostream &out) const;
+
+    /**
+     * @brief Reads a BigInt object back from its binary form
+     * Checks the magic, the version, the sign, the limb count against the buffer size and that the top limb is not zero, and throws an exception if any of them is invalid
+     *
+     * @param buffer The bytes written by serialize(), trailing bytes are ignored
+     * @return BigInt The deserialized BigInt object
+     */
+
+    static BigInt deserialize(std::span<const std::byte> buffer);
+
+    /**
+     * @brief Reads a BigInt object back from its binary form in an input stream, for example a checkpoint file opened in binary mode
+     * The limbs are read straight into the magnitude in large blocks, and an exception is thrown if the data is invalid or ends early
+     *
+     * @param in The input stream positioned at the start of the binary form
+     * @return BigInt The deserialized BigInt object
+     */
+
+    static BigInt deserialize(std::istream &in);
+
+    /**
+     * @brief Adds two arrays of BigInt objects element by element and writes result[i] = left[i] + right[i]
+     * The elements are processed in blocks: a block whose operands all fit in one limb is copied into structure-of-arrays form and added in a branch-free loop the compiler can vectorize across elements, other blocks use the operator `+=`
+     * The result elements are assigned in place so their existing storage is reused, and result may be the same array as left or right
+     * When the parallel mode is on (see setthreads()) the blocks are spread over the thread pool
+     *
+     * @param left The left operands
+     * @param right The right operands, same size as left
+     * @param result The preallocated output, same size as left
+     */
+
+    static void add_n(std::span<const BigInt> left, std::span<const BigInt> right, std::span<BigInt> result);
+
+    /**
+     * @brief Multiplies two arrays of BigInt objects element by element and writes result[i] = left[i] * right[i]
+     * Works in blocks like add_n(): single-limb blocks are multiplied in a structure-of-arrays loop, other blocks use the operator `*`
+     *
+     * @param left The left operands
+     * @param right The right operands, same size as left
+     * @param result The preallocated output, same size as left
+     */
+
+    static void mul_n(std::span<const BigInt> left, std::span<const BigInt> right, std::span<BigInt> result);
+
+    /**
+     * @brief Computes the modulus of two arrays of BigInt objects element by element and writes result[i] = left[i] % right[i]
+     * Works in blocks like add_n() and follows the operator `%`, so every result is non-negative and a zero divisor throws an exception
+     *
+     * @param left The dividends
+     * @param right The divisors, same size as left
+     * @param result The preallocated output, same size as left
+     */
+
+    static void mod_n(std::span<const BigInt> left, std::span<const BigInt> right, std::span<BigInt> result);
+
+    /**
+     * @brief Compares two arrays of BigInt objects element by element
+     * Works in blocks like add_n(), single-limb blocks are compared in a branch-free structure-of-arrays loop and other blocks use the operator `<=>`
+     *
+     * @param left The left operands
+     * @param right The right operands, same size as left
+     * @param result The preallocated output, same size as left, receives -1, 0 or 1 when left[i] is less than, equal to or greater than right[i]
+     */
+
+    static void compare_n(std::span<const BigInt> left, std::span<const BigInt> right, std::span<int> result);
+
+    /**
+     * @brief Multiplies all the factors of an array with a balanced product tree
+     * The array is split where the accumulated size of the factors reaches half of the total, so every multiplication combines operands of similar size and the fast multiplication methods apply
+     * In the parallel mode (see setthreads()) the two subtrees of a large node are evaluated on different threads
+     *
+     * @param factors The BigInt objects to multiply
+     * @return BigInt The product of all the factors, 1 for an empty array
+     */
+
+    static BigInt product(std::span<const BigInt> factors);
+
+    /**
+     * @brief Adds all the terms of an array
+     * The array is cut into blocks that are summed in place into partial sums, in parallel when the parallel mode is on, and the partial sums are then added together
+     *
+     * @param terms The BigInt objects to add
+     * @return BigInt The sum of all the terms, 0 for an empty array
+     */
+
+    static BigInt sum(std::span<const BigInt> terms);
+
+    /**
+     * @brief Computes n! with a balanced product tree over the range 2..n
+     * Short ranges are multiplied directly into one magnitude with the mul_1 kernel, and longer ranges are split in half like product()
+     *
+     * @param n The number whose factorial is computed
+     * @return BigInt n! (1 for n = 0 and n = 1)
+     */
+
+    static BigInt factorial(uint64_t n);
+
+    /**
+     * @brief Divides dividend by divisor when the division is known to leave no remainder, faster than operator/
+     * Uses Jebelean's exact division: the quotient is built from the low limbs up with the 2-adic inverse of the divisor, so there are no quotient estimates or corrections and only the low limbs of the dividend are read
+     * Useful to divide out a known factor such as a GCD or the denominator of a binomial coefficient. If the division is not exact the result is meaningless
+     *
+     * @param dividend The BigInt object (or view) to divide
+     * @param divisor The BigInt object (or view) that divides it exactly
+     * @return BigInt The quotient, with the usual sign rule
+     */
+
+    static BigInt divexact(const BigIntView &dividend, const BigIntView &divisor);
+
+    /**
+     * @brief Returns true if divisor divides dividend, without building a quotient or a remainder
+     * The powers of two are checked on the low bits and the odd part of the divisor with a Hensel reduction, a zero divisor divides only zero
+     *
+     * @param dividend The BigInt object (or view) to test
+     * @param divisor The BigInt object (or view) to divide by, signs are ignored
+     */
+
+    static bool divisible_by(const BigIntView &dividend, const BigIntView &divisor);
+
+    /**
+     * @brief Returns true if the 64-bit word divides dividend, with one multiplication per limb and no division instruction
+     *
+     * @param dividend The BigInt object (or view) to test
+     * @param divisor The word to divide by, zero divides only zero
+     */
+
+    static bool divisible_by_word(const BigIntView &dividend, uint64_t divisor);
+
+    /**
+     * @brief Returns the greatest common divisor of two values with Lehmer's method, which works on the top bits of the operands with single-limb arithmetic and touches the full operands once per 30 or so bits
+     *
+     * @param left The first BigInt object (or view), signs are ignored
+     * @param right The second BigInt object (or view)
+     * @return BigInt The non-negative greatest common divisor, 0 only when both values are 0
+     */
+
+    static BigInt gcd(const BigIntView &left, const BigIntView &right);
+
+    /**
+     * @brief Raises base to the power exponent by binary exponentiation from the top bit down, one squaring per bit and one product with the base per set bit
+     *
+     * @param base The BigInt object (or view) to raise
+     * @param exponent The power, pow(x, 0) is 1 for every x including 0
+     * @return BigInt base^exponent
+     */
+
+    static BigInt pow(const BigIntView &base, uint64_t exponent);
+
+    /**
+     * @brief Multiplies two BigInt objects on an executor and returns the future of the product, so the calling thread stays free
+     * The executor is any callable that accepts a std::function<void()>, for example a thread pool's post() wrapped in a lambda, and the work runs where it calls the function
+     * The multiplication checks the stop token between the subproducts of Karatsuba and the pieces of unbalanced products, and then the future throws std::system_error with std::errc::operation_canceled
+     * progress is called on the executing thread with the fraction of the work done, at most once per 0.1% and with 1 at the end
+     *
+     * @param executor Runs the work, called once with a std::function<void()>
+     * @param left The first factor, copied in constant time because the limbs are shared
+     * @param right The second factor
+     * @param stop Requests the cancellation when its std::stop_source is stopped
+     * @param progress Receives the progress between 0 and 1, may be empty
+     * @return std::future<BigInt> The product, or the exception that stopped it
+     */
+
+    template <typename Executor>
+    static std::future<BigInt> async_mul(Executor &&executor, BigInt left, BigInt right, std::stop_token stop = {}, std::function<void(double)> progress = {});
+
+    /**
+     * @brief Computes pow(base, exponent) on an executor like async_mul(), checking the stop token between the squarings and inside every large one
+     * The progress of every squaring is weighted by its estimated cost, so the last squarings, which take most of the time, also take most of the progress
+     */
+
+    template <typename Executor>
+    static std::future<BigInt> async_pow(Executor &&executor, BigInt base, uint64_t exponent, std::stop_token stop = {}, std::function<void(double)> progress = {});
+
+    /**
+     * @brief Converts a BigInt object to digits on an executor like async_mul(), checking the stop token at every division of the divide-and-conquer conversion
+     */
+
+    template <typename Executor>
+    static std::future<std::string> async_to_string(Executor &&executor, BigInt value, unsigned base = 10, std::stop_token stop = {}, std::function<void(double)> progress = {});
+
+    /**
+     * @brief Returns a uniform random BigInt object in [0, 2^bits), with the limbs taken straight from the engine and no radix conversion
+     * Numbers of more than 2^16 limbs are filled in independently seeded chunks, in parallel when the parallel mode is on (see setthreads()), with the same result either way
+     *
+     * @param bits The number of random bits, the result has at most that many
+     * @param engine A uniform random bit generator of 64-bit values, for example std::mt19937_64
+     * @return BigInt The random non-negative value
+     */
+
+    template <typename Engine>
+    static BigInt random_bits(uint64_t bits, Engine &engine);
+
+    /**
+     * @brief Returns a uniform random BigInt object in [0, bound) by exact rejection sampling
+     * A candidate of the bit length of bound is drawn from its top limb down and rejected as soon as its top limb exceeds the one of bound, so on average less than two candidates and little more than one top limb are drawn
+     * Throws std::invalid_argument if bound is not positive
+     *
+     * @param bound The exclusive upper bound, must be positive
+     * @param engine A uniform random bit generator of 64-bit values, for example std::mt19937_64
+     * @return BigInt The random value, uniform over 0, 1, ..., bound - 1
+     */
+
+    template <typename Engine>
+    static BigInt random_below(const BigIntView &bound, Engine &engine);
+
+private:
+    using limb = bigint_detail::limb;
+
+    /**
+     * @brief Private members of the BigInt class
+     * magnitude Stores the absolute value of a BigInt object as 64-bit limbs in little-endian order, without high zero limbs (zero has no limbs), shared with copies until one of them is modified
+     * sign Stores the sign of a BigInt object as a character ('+' or '-')
+     *
+     */
+
+    bigint_detail::limb_buffer magnitude;
+    char sign;
+
+    /**
+     * @brief Trims and validates the string input for constructing a valid BigInt object
+     * First Removes leading zeros and spaces to ensure the input is well-formatted.
+     * Then, checks the input for invalid characters or a misplaced sign ,if any is found an exception is thrown
+     *
+     * @param main_number The input string for trimming and validation process
+     */
+
+    void check_number(std::string &main_number);
+
+    /**
+     * @brief Converts a string of digits in the given base (without sign or leading spaces) to the binary magnitude
+     * In a power-of-two base every digit is a fixed group of bits, so the bits are placed directly in one pass
+     * Otherwise short strings are consumed a chunk at a time (19 digits in base 10), each chunk multiplying the magnitude by base^(chunk digits) and adding the chunk's value
+     * Longer strings go through radix_parser, which is subquadratic
+     *
+     * @param digits The digits of the magnitude, already validated
+     * @param base The base of the digits (2 to 36)
+     */
+
+    void set_magnitude_from_digits(std::string_view digits, unsigned base);
+
+    /**
+     * @brief Throws an exception if the base is not between 2 and 36
+     */
+
+    static void check_base(unsigned base);
+
+    /**
+     * @brief Returns the value of a digit character ('0'-'9', 'a'-'z' or 'A'-'Z'), or 36 for any other character
+     */
+
+    static unsigned digit_value(char c);
+
+    /**
+     * @brief Returns the largest power of the base that fits in a limb, and in digits its number of digits (19 and 10^19 in base 10)
+     */
+
+    static limb chunk_scale(unsigned base, unsigned &digits);
+
+    /**
+     * @brief Appends the digits of a short magnitude to out by repeatedly dividing it by chunk_scale(base), padded with leading zeros to width digits
+     */
+
+    static void append_digits(std::string &out, std::span<const limb> limbs, unsigned base, size_t width);
+
+    struct radix_parser;
+    struct radix_printer;
+
+    /**
+     * @brief Removes the high zero limbs of the magnitude and makes the sign of zero positive
+     */
+
+    void trim();
+
+    /**
+     * @brief Adds a signed magnitude to the current BigInt object (*this) in place
+     * Shared by the operators `+=` and `-=` (which flips the sign) and by the arithmetic on views, so none of them copies *this or the operand
+     *
+     * @param operand The limbs of the value to be added to *this
+     * @param operand_sign The sign of the value to be added ('+' or '-')
+     */
+
+    void add_signed(std::span<const limb> operand, char operand_sign);
+
+    /**
+     * @brief Sets the current BigInt object (*this) to the two-limb value high * 2^64 + low with the given sign, reusing the storage of the magnitude
+     */
+
+    void assign_two_limbs(limb low, limb high, bool negative);
+
+    /**
+     * @brief Structure-of-arrays copy of a block of single-limb operands used by the batch functions
+     * Holds the magnitudes and the signs (1 for negative) of up to 256 left and right operands
+     */
+
+    struct batch_block;
+
+    /**
+     * @brief Checks that the spans of a batch function have the same size and throws an exception otherwise
+     */
+
+    static void check_batch_sizes(size_t left, size_t right, size_t result);
+
+    /**
+     * @brief Multiplies the factors of a non-empty array with a product tree split by size, used by product()
+     *
+     * @param factors The BigInt objects to multiply
+     * @param weight The total number of limbs of the factors plus one per factor
+     */
+
+    static BigInt product_tree(std::span<const BigInt> factors, size_t weight);
+
+    /**
+     * @brief Multiplies all the integers of the range [low, high] with a product tree split in half, used by factorial()
+     */
+
+    static BigInt range_product(uint64_t low, uint64_t high);
+
+    /**
+     * @brief Compares the magnitudes of two BigInt objects limb by limb starting from the most significant one
+     *
+     * @return int a negative number, zero or a positive number if the left magnitude is less than, equal to or greater than the right one
+     */
+
+    static int compare_magnitude(std::span<const limb> left, std::span<const limb> right);
+
+    /**
+     * @brief Compares two values, shared by the comparison operators of BigInt and BigIntView
+     * First compares the signs (zero is unsigned), then the number of limbs, and only if both are equal compares the limbs starting from the most significant one
+     */
+
+    static std::strong_ordering compare(const BigIntView &left, const BigIntView &right);
+
+    /**
+     * @brief Multiplies two values, shared by the operator `*` of BigInt and BigIntView
+     */
+
+    static BigInt multiply(const BigIntView &left, const BigIntView &right);
+
+    /**
+     * @brief Divides two values with the quotient truncated toward zero, shared by the operator `/` of BigInt and BigIntView
+     */
+
+    static BigInt divide(const BigIntView &dividend, const BigIntView &divisor);
+
+    /**
+     * @brief Computes the non-negative modulus of two values, shared by the operator `%` of BigInt and BigIntView
+     */
+
+    static BigInt modulo(const BigIntView &dividend, const BigIntView &divisor);
+
+    /**
+     * @brief Converts a magnitude to its digits in the given base, shared by getnumber() and to_string() of BigInt and BigIntView
+     * Power-of-two bases read the bits directly, short magnitudes use append_digits() and long ones radix_printer
+     */
+
+    static std::string magnitude_to_digits(std::span<const limb> limbs, unsigned base);
+
+    /**
+     * @brief Returns the number of decimal digits of a magnitude, shared by getsize() of BigInt and BigIntView
+     * The count is floor(log10(value)) + 1 with the logarithm taken from the top two limbs; only when it lies too close to an integer for double precision is the value compared once with 10^k
+     */
+
+    static size_t decimal_digits(std::span<const limb> limbs);
+
+    /**
+     * @brief Returns the magnitude rounded to the precision of the floating-point type F (ties to even) and scaled into [0.5, 1), with the sign applied
+     * The binary exponent is written to exponent, so the value is about result * 2^exponent. Shared by to_double(), to_long_double(), frexp() and fits_in()
+     */
+
+    template <typename F>
+    F rounded_mantissa(int64_t &exponent) const;
+
+    /**
+     * @brief Returns the rounded value as the floating-point type F, or an infinity if it is out of the range of F
+     */
+
+    template <typename F>
+    F to_floating() const;
+
+    /**
+     * @brief Checks the 16-byte header of a binary form and returns the number of limbs that follow it, throws an exception if the header is invalid
+     *
+     * @param header The first 16 bytes of the binary form
+     * @param negative Receives whether the serialized value is negative
+     */
+
+    static uint64_t read_serial_header(std::span<const std::byte> header, bool &negative);
+
+    /**
+     * @brief Writes the 16-byte header of the binary form of the current BigInt object (*this)
+     */
+
+    void write_serial_header(std::byte *header) const;
+
+    friend class BigIntView;
+    friend class DecimalBigInt;
+    friend BigInt operator+(const BigIntView &left, const BigIntView &right);
+    friend BigInt operator-(const BigIntView &left, const BigIntView &right);
+    friend BigInt operator*(const BigIntView &left, const BigIntView &right);
+    friend BigInt operator/(const BigIntView &left, const BigIntView &right);
+    friend BigInt operator%(const BigIntView &left, const BigIntView &right);
+    friend bool operator==(const BigIntView &left, const BigIntView &right);
+    friend std::strong_ordering operator<=>(const BigIntView &left, const BigIntView &right);
+
+    /**
+     * @brief Divides the magnitude of the dividend by the magnitude of the divisor (which must not be zero)
+     *
+     * @param dividend The magnitude to divide
+     * @param divisor The magnitude to divide by
+     * @param quotient Receives the trimmed magnitude of the quotient
+     * @param remainder Receives the trimmed magnitude of the remainder
+     */
+
+    static void divide_magnitude(std::span<const limb> dividend, std::span<const limb> divisor, bigint_detail::limb_buffer &quotient, bigint_detail::limb_buffer &remainder);
+
+    /**
+     * @brief Splits the input string into the sign and numerical value for a BigInt object
+     * Receives a well-formatted input string passed from check_number() and splits it into the sign and the numerical part
+     * The numerical part is then converted to the binary magnitude that the operators work on
+     *
+     * @param raw_number the input string for splitting sign and number
+     */
+
+    void split_sign_and_number(std::string &raw_number);
+};
+
+/**
+ * @brief Specialization of std::hash for BigInt class
+ * Allows BigInt objects to be used as keys of unordered containers such as std::unordered_map and std::unordered_set
+ */
+
+template <>
+struct std::hash<BigInt>
+{
+    size_t operator()(const BigInt &bigint) const noexcept
+    {
+        return bigint.hash();
+    }
+};
+
+/**
+ * @brief Converts a stream of digits to a magnitude without keeping the digits
+ * Digits are collected into blocks of 32 chunks (608 digits in base 10), and each full block is converted on its own and pushed on a stack with level 0
+ * Like a binary counter, two neighbours of equal level L are merged into one of level L + 1 as high * base^(block digits * 2^L) + low, so every multiplication is balanced
+ * A power of the base is kept as its odd part and a shift (5^k and k bits for 10^k), which is 30 percent shorter in base 10, and each merge is written straight into the limbs of its result
+ * A merge of operands as long as a quarter of the stack drops the smaller cached powers first
+ * The carry into the oldest segment, and finish(), fold the whole stack with Horner's rule inside one buffer of the final size, multiplying it there piece by piece, so no full-size product or scratch is alive next to it
+ * The peak is about 2.2 times the size of the result, below one byte per decimal digit read
+ */
+
+struct BigInt::radix_parser
+{
+    /**
+     * @brief Creates a parser for digits in the given base (2 to 36)
+     */
+
+    explicit radix_parser(unsigned base);
+
+    /**
+     * @brief Adds count more digits, already validated, after the ones pushed so far
+     */
+
+    void push(const char *digits, size_t count);
+
+    /**
+     * @brief Returns the non-negative value of all the digits pushed so far
+     */
+
+    BigInt finish();
+
+private:
+    struct segment
+    {
+        BigInt value;
+        size_t level;
+    };
+
+    /**
+     * @brief Number of pieces a fold multiplies the whole value in, which bounds the saved piece, the piece product and its scratch to 5/8 of the value
+     */
+
+    static constexpr size_t fold_pieces = 8;
+
+    unsigned base;
+    unsigned base_twos; // base = odd_base * 2^base_twos
+    limb odd_base;
+    size_t block_digits;
+    size_t blocks = 0; // full blocks pushed so far
+    std::vector<segment> stack; // the oldest (most significant) segment first, levels strictly decreasing
+    std::vector<BigInt> powers; // powers[L] = odd_base^(block_digits * 2^L), an empty entry is rebuilt when it is needed again
+    std::string block;
+
+    const BigInt &power(size_t level);
+    size_t power_shift(size_t level) const;
+    BigInt odd_power(size_t exponent) const;
+    BigInt fold(BigInt partial, size_t partial_digits);
+    static void merge(BigInt &high, const BigInt &odd, size_t shift, BigInt low);
+    static void multiply_add(limb *rp, size_t &size, size_t room, size_t piece, std::span<const limb> odd, size_t shift);
+};
+
+/**
+ * @brief Converts a long magnitude to digits in a base that is not a power of two in divide-and-conquer fashion
+ * With P(k) = chunk_scale(base)^(2^k), a number below P(k) is split by P(k - 1) into a high and a low half, whose digits are written recursively, the low half padded with zeros
+ * The divisions use Barrett's method with a reciprocal of every power computed once by Newton's iteration, so they cost a few multiplications instead of a quadratic long division
+ */
+
+struct BigInt::radix_printer
+{
+    /**
+     * @brief Number of limbs below which repeated division by one limb is faster than splitting
+     */
+
+    static constexpr size_t threshold = 256;
+
+    /**
+     * @brief Creates a printer for digits in the given base (2 to 36)
+     */
+
+    explicit radix_printer(unsigned base);
+
+    /**
+     * @brief Returns the digits of a non-zero magnitude, without leading zeros
+     */
+
+    std::string print(std::span<const limb> limbs);
+
+private:
+    struct power
+    {
+        BigInt value;      // P(k)
+        BigInt normalized; // P(k) shifted left so the top bit of its top limb is set
+        unsigned shift;
+        BigInt reciprocal; // floor((B^(2 L) - 1) / normalized) with B = 2^64 and L the number of limbs of normalized, computed on first use
+        size_t digits;
+    };
+
+    unsigned base;
+    std::vector<power> powers;
+
+    power &get(size_t level);
+    void write(std::string &out, const BigInt &value, size_t level, bool pad);
+    void divide(const BigInt &dividend, power &divisor, BigInt &quotient, BigInt &remainder);
+    static BigInt reciprocal(const BigInt &divisor);
+    static BigInt shift_left(const BigInt &value, size_t bits);
+    static BigInt shift_right(const BigInt &value, size_t bits);
+};
+
+/**
+ * @brief A read-only view of an arbitrary-precision integer whose limbs live in memory owned by someone else
+ * A view can point at a BigInt object, at any array of limbs, or straight at the binary form written by BigInt::serialize() inside a memory-mapped file or a network buffer
+ * Arithmetic and comparison operators accept views and BigInt objects in any combination and read the limbs in place, only the result is a new BigInt object
+ * The memory a view points at must stay valid and unchanged while the view is used
+ */
+
+class BigIntView
+{
+
+public:
+    /**
+     * @brief The constructor that views the value of a BigInt object without copying it
+     * Not explicit, so a BigInt object can be passed wherever a view is expected
+     *
+     * @param bigint The BigInt object to view, which must outlive the view
+     */
+
+    BigIntView(const BigInt &bigint);
+
+    /**
+     * @brief The constructor that views an array of 64-bit limbs in little-endian order as a signed value
+     * High zero limbs are ignored, so the array does not need to be trimmed
+     *
+     * @param sign The sign of the value ('+' or '-')
+     * @param limbs The limbs of the magnitude, least significant first
+     */
+
+    BigIntView(char sign, std::span<const uint64_t> limbs);
+
+    /**
+     * @brief Creates a view that points straight at the limbs of a binary form written by BigInt::serialize(), without copying them
+     * The header is validated like BigInt::deserialize() does. Because the limbs are read in place, the buffer must be 8-byte aligned and the machine must be little-endian, otherwise an exception is thrown
+     *
+     * @param buffer The binary form, for example a region of a memory-mapped file
+     * @return BigIntView A view of the serialized value
+     */
+
+    static BigIntView from_bytes(std::span<const std::byte> buffer);
+
+    /**
+     * @brief Returns the sign of the viewed value ('+' or '-')
+     */
+
+    char getsign() const;
+
+    /**
+     * @brief Returns the limbs of the viewed magnitude, least significant first and without high zero limbs
+     */
+
+    std::span<const uint64_t> getlimbs() const;
+
+    /**
+     * @brief Returns the decimal digits of the viewed magnitude, like BigInt::getnumber()
+     */
+
+    std::string getnumber() const;
+
+    /**
+     * @brief Returns the number of decimal digits of the viewed magnitude, like BigInt::getsize()
+     */
+
+    size_t getsize() const;
+
+    /**
+     * @brief Returns the number of bytes of the binary form of the viewed value, which is also the distance to the next record when several binary forms are stored back to back
+     */
+
+    size_t serialized_size() const;
+
+    friend BigInt operator+(const BigIntView &left, const BigIntView &right);
+    friend BigInt operator-(const BigIntView &left, const BigIntView &right);
+    friend BigInt operator*(const BigIntView &left, const BigIntView &right);
+    friend BigInt operator/(const BigIntView &left, const BigIntView &right);
+    friend BigInt operator%(const BigIntView &left, const BigIntView &right);
+    friend bool operator==(const BigIntView &left, const BigIntView &right);
+    friend std::strong_ordering operator<=>(const BigIntView &left, const BigIntView &right);
+    friend std::ostream &operator<<(std::ostream &out, const BigIntView &view);
+
+private:
+    /**
+     * @brief Private members of the BigIntView class
+     * limbs Points at the limbs of the viewed magnitude without high zero limbs
+     * sign Stores the sign of the viewed value as a character ('+' or '-')
+     */
+
+    std::span<const uint64_t> limbs;
+    char sign;
+
+    friend class BigInt;
+};
+
+/**
+ * @brief An accumulator for adding a long stream of BigInt values faster than repeated +=
+ * The running sums are kept in carry-save form: every 64-bit limb has a 64-bit carry counter next to it, which makes a 128-bit column with 64 bits of headroom
+ * Adding a value touches only as many columns as the value has limbs and never propagates a carry; the carries are resolved once, when value() is called
+ * Positive and negative inputs go into two separate sums that are subtracted at the end
+ * An accumulator is not thread-safe, so parallel code gives every thread its own accumulator and merges them at the end
+ */
+
+class BigIntAccumulator
+{
+
+public:
+    /**
+     * @brief The Default constructor which Construct an accumulator whose value is zero
+     */
+
+    BigIntAccumulator();
+
+    /**
+     * @brief Adds a value (a BigInt object or a view) to the accumulator
+     * Costs one pass over the limbs of the value, whatever the size of the running sum
+     */
+
+    BigIntAccumulator &operator+=(const BigIntView &value);
+
+    /**
+     * @brief Subtracts a value (a BigInt object or a view) from the accumulator
+     */
+
+    BigIntAccumulator &operator-=(const BigIntView &value);
+
+    /**
+     * @brief Adds the running sums of another accumulator to this one, for example the accumulator of another thread
+     *
+     * @param other The accumulator to merge, which is left unchanged
+     */
+
+    void merge(const BigIntAccumulator &other);
+
+    /**
+     * @brief Resolves the pending carries and returns the sum of every value added so far
+     */
+
+    BigInt value() const;
+
+    /**
+     * @brief Resets the accumulator to zero and keeps its memory for reuse
+     */
+
+    void clear();
+
+private:
+    /**
+     * @brief One running sum in carry-save form
+     * low holds the low 64 bits of every column and carries[i] counts the carries out of low[i] that still have to be added to column i + 1
+     */
+
+    struct column_sum
+    {
+        std::vector<uint64_t> low;
+        std::vector<uint64_t> carries;
+
+        void add(std::span<const uint64_t> limbs);
+        void add(const column_sum &other);
+        std::vector<uint64_t> resolve() const;
+        void fold();
+    };
+
+    /**
+     * @brief Private members of the BigIntAccumulator class
+     * positive and negative Hold the sums of the positive and of the negative inputs
+     * pending Bounds every carry counter, the counters are folded into the limbs before it could overflow
+     */
+
+    column_sum positive;
+    column_sum negative;
+    uint64_t pending;
+
+    void count_additions(uint64_t additions);
+};
+
+/**
+ * @brief A class for exact rational numbers, a numerator and a denominator BigInt
+ * The denominator is always positive, but the fraction is reduced lazily: arithmetic returns the fraction as it comes out of the cross products, and the GCD is divided out only by normalize() or when the numerator and denominator have grown past twice their size at the last reduction
+ * Comparisons never need the reduced form: they cross-multiply and first try to decide from the bit lengths alone
+ * The const members never write the object, so like BigInt a Rational object can be read from several threads at once as long as none of them modifies it. getnumerator(), getdenominator() and printing return the reduced form of an unreduced fraction without storing it; call normalize() first to reduce once for many reads
+ */
+
+class Rational
+{
+
+public:
+    /**
+     * @brief The Default constructor which Construct a new Rational object and initialize it to 0/1
+     */
+
+    Rational();
+
+    /**
+     * @brief The constructor that takes a signed 64-bit integer and Construct the Rational object n/1
+     */
+
+    Rational(const int64_t integer);
+
+    /**
+     * @brief The constructor that takes a BigInt object and Construct the Rational object n/1
+     */
+
+    Rational(const BigInt &integer);
+
+    /**
+     * @brief The constructor that takes a numerator and a denominator, which do not need to be reduced
+     * If the denominator is zero an exception is thrown
+     *
+     * @param numerator The numerator, with any sign
+     * @param denominator The denominator, with any sign
+     */
+
+    Rational(const BigInt &numerator, const BigInt &denominator);
+
+    /**
+     * @brief Returns the numerator of the reduced fraction, which carries the sign
+     * If the fraction is not reduced yet, the GCD is computed for this call and the object is left as it is
+     */
+
+    BigInt getnumerator() const;
+
+    /**
+     * @brief Returns the denominator of the reduced fraction, which is always positive
+     * If the fraction is not reduced yet, the GCD is computed for this call and the object is left as it is
+     */
+
+    BigInt getdenominator() const;
+
+    /**
+     * @brief Divides the GCD out of the numerator and the denominator now, so that reading or printing the fraction no longer has to
+     */
+
+    void normalize();
+
+    /**
+     * @brief Returns true if the denominator of the reduced fraction is 1
+     */
+
+    bool isinteger() const;
+
+    /**
+     * @brief Arithmetic operators, the results are exact and reduced lazily
+     * Division by zero throws an exception
+     */
+
+    Rational operator+(const Rational &operand) const;
+    Rational operator-(const Rational &operand) const;
+    Rational operator*(const Rational &operand) const;
+    Rational operator/(const Rational &operand) const;
+    Rational &operator+=(const Rational &operand);
+    Rational &operator-=(const Rational &operand);
+    Rational &operator*=(const Rational &operand);
+    Rational &operator/=(const Rational &operand);
+    Rational operator-() const;
+
+    /**
+     * @brief Compares the values of two Rational objects, reduced or not
+     */
+
+    bool operator==(const Rational &operand) const;
+    std::strong_ordering operator<=>(const Rational &operand) const;
+
+    /**
+     * @brief Outputs the reduced fraction as numerator/denominator, or just the numerator when the denominator is 1
+     */
+
+    friend std::ostream &operator<<(std::ostream &out, const Rational &rational);
+
+private:
+    /**
+     * @brief Private members of the Rational class
+     * numerator and denominator Store the fraction with a positive denominator, not necessarily reduced
+     * reduced Is true when the GCD of the numerator and the denominator is known to be 1
+     * reduced_limbs Stores the total size in limbs of the numerator and the denominator at the last reduction, the base of the growth threshold
+     */
+
+    BigInt numerator;
+    BigInt denominator;
+    bool reduced;
+    size_t reduced_limbs;
+
+    /**
+     * @brief Total size in limbs below which a fraction is never reduced automatically, GCDs of such small numbers cost more than the growth they prevent
+     */
+
+    static constexpr size_t reduce_threshold = 8;
+
+    static size_t limb_count(const BigInt &value);
+    static size_t bit_length(const BigInt &value);
+
+    /**
+     * @brief Builds a fraction from a numerator and a positive denominator and reduces it if it has grown past the threshold
+     */
+
+    static Rational from_parts(BigInt numerator, BigInt denominator);
+
+    /**
+     * @brief Updates the reduced flag after an operation and reduces the fraction if it has grown past twice its size at the last reduction
+     */
+
+    void settle();
+};
+
+/**
+ * @brief An arbitrary-precision integer stored in base 10^19 instead of base 2^64, for workloads dominated by decimal input and output
+ * Each limb holds 19 decimal digits, so the constructor from a string, getnumber(), getsize() and operator<< are linear in the number of digits, while addition, subtraction and multiplication still work on 64-bit words
+ * The interface follows BigInt. Division by a divisor below 10^19 is done directly in base 10^19, longer divisors go through the binary backend and back
+ * Select the backend at compile time with BasicBigInt<Base10Limbs> or BasicBigInt<Base2Limbs>, which is BigInt itself
+ */
+
+class DecimalBigInt
+{
+
+public:
+    /**
+     * @brief The Default constructor which Construct a new DecimalBigInt object and initialize it to zero
+     */
+
+    DecimalBigInt();
+
+    /**
+     * @brief The constructor that takes a signed 64-bit integer and Construct a new DecimalBigInt object
+     */
+
+    DecimalBigInt(const int64_t int_number);
+
+    /**
+     * @brief The constructor that takes a string of digits and construct a new DecimalBigInt object, with the same trimming and validation as BigInt
+     * The digits are cut into limbs of 19 from the end, a single linear pass
+     */
+
+    DecimalBigInt(const std::string &str_number);
+
+    /**
+     * @brief The constructor that converts the value of a binary BigInt object
+     */
+
+    explicit DecimalBigInt(const BigInt &bigint);
+
+    /**
+     * @brief Returns the value as a binary BigInt object
+     */
+
+    BigInt to_bigint() const;
+
+    /**
+     * @brief Getters and setters with the same meaning as in BigInt, getnumber() and getsize() are linear and need no base conversion
+     */
+
+    char getsign() const;
+    void setsign(char ch);
+    std::string getnumber() const;
+    void setnumber(const std::string &str);
+    size_t getsize() const;
+    DecimalBigInt abs() const;
+
+    /**
+     * @brief Arithmetic operators with the same semantics as in BigInt: / truncates toward zero and % is never negative
+     * An exception is thrown for a division by zero
+     */
+
+    DecimalBigInt operator+(const DecimalBigInt &operand) const;
+    DecimalBigInt operator-(const DecimalBigInt &operand) const;
+    DecimalBigInt operator*(const DecimalBigInt &operand) const;
+    DecimalBigInt operator/(const DecimalBigInt &operand) const;
+    DecimalBigInt operator%(const DecimalBigInt &operand) const;
+    DecimalBigInt &operator+=(const DecimalBigInt &operand);
+    DecimalBigInt &operator-=(const DecimalBigInt &operand);
+    DecimalBigInt &operator*=(const DecimalBigInt &operand);
+    DecimalBigInt &operator/=(const DecimalBigInt &operand);
+    DecimalBigInt &operator%=(const DecimalBigInt &operand);
+    DecimalBigInt operator-() const;
+    DecimalBigInt &operator++();
+    DecimalBigInt operator++(int);
+    DecimalBigInt &operator--();
+    DecimalBigInt operator--(int);
+
+    /**
+     * @brief Comparison operators, the other relational operators are derived from these two
+     */
+
+    bool operator==(const DecimalBigInt &operand) const;
+    std::strong_ordering operator<=>(const DecimalBigInt &operand) const;
+
+    /**
+     * @brief Outputs a DecimalBigInt object with its sign and value, like BigInt
+     */
+
+    friend std::ostream &operator<<(std::ostream &out, const DecimalBigInt &bigint);
+
+private:
+    using limb = bigint_detail::limb;
+
+    /**
+     * @brief Private members of the DecimalBigInt class
+     * magnitude Stores the absolute value as limbs in base 10^19 in little-endian order, without high zero limbs (zero has no limbs)
+     * sign Stores the sign as a character ('+' or '-')
+     */
+
+    std::vector<limb> magnitude;
+    char sign;
+
+    void trim();
+    void add_signed(const std::vector<limb> &operand, char operand_sign);
+    void set_from_digits(std::string_view digits);
+    static int compare_magnitude(const std::vector<limb> &left, const std::vector<limb> &right);
+};
+
+/**
+ * @brief Tags that select the limb representation of BasicBigInt at compile time
+ * Base2Limbs is the binary BigInt, fastest for arithmetic, and Base10Limbs is DecimalBigInt, fastest for decimal input and output
+ */
+
+struct Base2Limbs
+{
+};
+
+struct Base10Limbs
+{
+};
+
+template <typename Limbs>
+struct bigint_backend;
+
+template <>
+struct bigint_backend<Base2Limbs>
+{
+    using type = BigInt;
+};
+
+template <>
+struct bigint_backend<Base10Limbs>
+{
+    using type = DecimalBigInt;
+};
+
+/**
+ * @brief The arbitrary-precision integer type with the limb representation chosen by the tag, for example BasicBigInt<Base10Limbs> for a report generator
+ */
+
+template <typename Limbs>
+using BasicBigInt = typename bigint_backend<Limbs>::type;
+
+BigInt::BigInt()
+{
+    sign = '+';
+}
+
+BigInt::BigInt(int64_t int_num)
+{
+    sign = (int_num < 0) ? '-' : '+';
+    uint64_t absolute = (int_num < 0) ? (0 - static_cast<uint64_t>(int_num)) : static_cast<uint64_t>(int_num); // negating in unsigned arithmetic also works for the int64_t min value
+    if (absolute != 0)
+        magnitude.push_back(absolute);
+}
+
+BigInt::BigInt(const std::string &str_num)
+{
+    std::string temp = str_num;
+
+    check_number(temp);
+    split_sign_and_number(temp);
+}
+
+BigInt::BigInt(const BigIntView &view)
+{
+    magnitude.assign(view.limbs.begin(), view.limbs.end());
+    sign = magnitude.empty() ? '+' : view.sign;
+}
+
+BigInt::BigInt(const std::string &str_number, unsigned base)
+{
+    check_base(base);
+
+    std::size_t position = str_number.find_first_not_of(' ');
+    if (position == std::string::npos)
+    {
+        throw std::invalid_argument("Input is empty ");
+    }
+
+    sign = '+';
+    if (str_number[position] == '-' || str_number[position] == '+')
+    {
+        sign = str_number[position];
+        ++position;
+    }
+
+    std::string_view digits(str_number);
+    digits.remove_prefix(position);
+    if (digits.empty() || std::any_of(digits.begin(), digits.end(), [base](char c)
+                                      { return digit_value(c) >= base; }))
+    {
+        throw std::invalid_argument("Input contains invalid characters");
+    }
+
+    set_magnitude_from_digits(digits, base);
+    trim();
+}
+
+void BigInt::split_sign_and_number(std::string &raw_number)
+{
+    sign = '+';
+    std::size_t digits_position = 0;
+
+    if (raw_number[0] == '-' || raw_number[0] == '+')
+    {
+        sign = raw_number[0];
+        digits_position = 1;
+    }
+
+    set_magnitude_from_digits(std::string_view(raw_number).substr(digits_position), 10);
+    trim();
+}
+
+// find_first_not_of() from cppreference.com is a member function of std::string ,it finds the first character equal to none of the characters in the given character sequence
+void BigInt::check_number(std::string &main_number)
+{
+    std::size_t non_space_position = main_number.find_first_not_of(' '); // it finds the first position in the string that is not a space (' ')
+    if (non_space_position == std::string::npos)                         // If all characters are spaces, the function returns std::string::npos, indicating input is all spaces
+    {
+        throw std::invalid_argument("Input is empty ");
+    }
+    main_number = main_number.substr(non_space_position);
+
+    std::size_t non_zero_position = main_number.find_first_not_of('0'); // it finds first position in the string that is not a zero ('0')
+    if (non_zero_position == std::string::npos)                         // If all characters are zeros, the function returns std::string::npos and  string is set to "0"
+    {
+
+        main_number.assign(1, '0');
+    }
+    else
+    {
+        main_number = main_number.substr(non_zero_position);
+    }
+
+    if (main_number.find_first_not_of("0123456789+-") != std::string::npos) // it checks the trimmed input string to find any character that is not part of the valid set (0123456789+-)
+    {
+        throw std::invalid_argument("Input contains invalid characters");
+    }
+
+    if (main_number.find_first_of("+-", 1) != std::string::npos || main_number.find_first_of("0123456789") == std::string::npos) // a sign is only valid in front of the digits and at least one digit must follow it
+    {
+        throw std::invalid_argument("Input contains invalid characters");
+    }
+}
+
+void BigInt::check_base(unsigned base)
+{
+    if (base < 2 || base > 36)
+    {
+        throw std::invalid_argument("Base must be between 2 and 36");
+    }
+}
+
+unsigned BigInt::digit_value(char c)
+{
+    if (c >= '0' && c <= '9')
+        return static_cast<unsigned>(c - '0');
+    if (c >= 'a' && c <= 'z')
+        return static_cast<unsigned>(c - 'a') + 10;
+    if (c >= 'A' && c <= 'Z')
+        return static_cast<unsigned>(c - 'A') + 10;
+    return 36;
+}
+
+BigInt::limb BigInt::chunk_scale(unsigned base, unsigned &digits)
+{
+    limb scale = base;
+    digits = 1;
+    while (scale <= ~limb{0} / base)
+    {
+        scale *= base;
+        ++digits;
+    }
+    return scale;
+}
+
+void BigInt::set_magnitude_from_digits(std::string_view digits, unsigned base)
+{
+    bigint_detail::stat_scope scope(BigIntOp::parse, 0);
+    magnitude.clear();
+
+    if (std::has_single_bit(base)) // every digit is a fixed group of bits, least significant digit last
+    {
+        bigint_detail::note_tier(BigIntTier::basecase);
+        unsigned bits_per_digit = static_cast<unsigned>(std::countr_zero(base));
+        magnitude.assign((digits.size() * bits_per_digit + 63) / 64, 0);
+        limb *limbs = magnitude.data();
+        std::size_t bit = 0;
+        for (std::size_t i = digits.size(); i > 0; --i, bit += bits_per_digit)
+        {
+            limb value = digit_value(digits[i - 1]);
+            limbs[bit / 64] |= value << (bit % 64);
+            if (bit % 64 + bits_per_digit > 64) // the digit straddles two limbs
+                limbs[bit / 64 + 1] |= value >> (64 - bit % 64);
+        }
+        while (!magnitude.empty() && magnitude.back() == 0)
+            magnitude.pop_back();
+        scope.set_limbs(magnitude.size());
+        return;
+    }
+
+    unsigned chunk_digits;
+    chunk_scale(base, chunk_digits);
+    if (digits.size() > 32 * std::size_t{chunk_digits})
+    {
+        bigint_detail::note_tier(BigIntTier::divide_and_conquer);
+        radix_parser parser(base);
+        parser.push(digits.data(), digits.size());
+        magnitude = std::move(parser.finish().magnitude);
+        scope.set_limbs(magnitude.size());
+        return;
+    }
+
+    bigint_detail::note_tier(BigIntTier::basecase);
+    magnitude.reserve(digits.size() / chunk_digits + 1);
+
+    std::size_t position = 0;
+    std::size_t first_chunk = digits.size() % chunk_digits;
+    if (first_chunk == 0)
+        first_chunk = chunk_digits;
+
+    while (position < digits.size())
+    {
+        std::size_t length = (position == 0) ? first_chunk : chunk_digits;
+        limb chunk_value = 0;
+        limb scale = 1;
+        for (std::size_t i = position; i < position + length; ++i)
+        {
+            chunk_value = chunk_value * base + digit_value(digits[i]);
+            scale *= base;
+        }
+        position += length;
+
+        limb carry = bigint_detail::kernels().mul_1(magnitude.data(), magnitude.data(), magnitude.size(), scale);
+        for (std::size_t i = 0; i < magnitude.size() && chunk_value != 0; ++i) // adds the value of the chunk to the shifted magnitude
+        {
+            magnitude[i] += chunk_value;
+            chunk_value = (magnitude[i] < chunk_value) ? 1 : 0;
+        }
+        carry += chunk_value;
+        if (carry != 0)
+            magnitude.push_back(carry);
+    }
+    scope.set_limbs(magnitude.size());
+}
+
+void BigInt::trim()
+{
+    while (!magnitude.empty() && magnitude.back() == 0)
+        magnitude.pop_back();
+    if (magnitude.empty())
+        sign = '+';
+}
+
+void BigInt::append_digits(std::string &out, std::span<const limb> limbs, unsigned base, size_t width)
+{
+    static const char symbols[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    unsigned chunk_digits;
+    const limb scale = chunk_scale(base, chunk_digits);
+
+    std::vector<limb> remaining(limbs.begin(), limbs.end());
+    while (!remaining.empty() && remaining.back() == 0)
+        remaining.pop_back();
+    std::vector<limb> chunks; // chunks of chunk_digits digits, least significant first
+    chunks.reserve(remaining.size() * 64 / chunk_digits + 1);
+
+    while (!remaining.empty())
+    {
+        chunks.push_back(bigint_detail::divrem_1(remaining.data(), remaining.data(), remaining.size(), scale));
+        if (remaining.back() == 0)
+            remaining.pop_back();
+    }
+
+    char buffer[64];
+    size_t first_size = 0; // the most significant chunk is written without its leading zeros
+    if (!chunks.empty())
+        for (limb chunk = chunks.back(); chunk != 0; chunk /= base)
+            buffer[63 - first_size++] = symbols[chunk % base];
+
+    size_t total = first_size + (chunks.empty() ? 0 : (chunks.size() - 1) * chunk_digits);
+    if (width > total)
+        out.append(width - total, '0');
+    else if (total == 0)
+        out += '0';
+    out.append(buffer + 64 - first_size, first_size);
+
+    for (std::size_t i = chunks.size(); i > 1; --i)
+    {
+        limb chunk = chunks[i - 2];
+        for (unsigned digit = chunk_digits; digit > 0; --digit) // every chunk after the first one keeps its leading zeros
+        {
+            buffer[digit - 1] = symbols[chunk % base];
+            chunk /= base;
+        }
+        out.append(buffer, chunk_digits);
+    }
+}
+
+std::string BigInt::magnitude_to_digits(std::span<const limb> limbs, unsigned base)
+{
+    bigint_detail::stat_scope scope(BigIntOp::print, limbs.size());
+    if (limbs.empty())
+        return "0";
+
+    if (std::has_single_bit(base)) // every digit is a fixed group of bits
+    {
+        bigint_detail::note_tier(BigIntTier::basecase);
+        static const char symbols[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+        unsigned bits_per_digit = static_cast<unsigned>(std::countr_zero(base));
+        std::size_t bits = 64 * limbs.size() - static_cast<std::size_t>(std::countl_zero(limbs.back()));
+        std::size_t count = (bits + bits_per_digit - 1) / bits_per_digit;
+        std::string result(count, '0');
+        std::size_t bit = 0;
+        for (std::size_t i = count; i > 0; --i, bit += bits_per_digit)
+        {
+            limb value = limbs[bit / 64] >> (bit % 64);
+            if (bit % 64 + bits_per_digit > 64 && bit / 64 + 1 < limbs.size()) // the digit straddles two limbs
+                value |= limbs[bit / 64 + 1] << (64 - bit % 64);
+            result[i - 1] = symbols[value & (base - 1)];
+        }
+        return result;
+    }
+
+    if (limbs.size() > radix_printer::threshold)
+    {
+        bigint_detail::note_tier(BigIntTier::divide_and_conquer);
+        return radix_printer(base).print(limbs);
+    }
+
+    bigint_detail::note_tier(BigIntTier::basecase);
+    std::string result;
+    append_digits(result, limbs, base, 0);
+    return result;
+}
+
+std::string BigInt::getnumber() const
+{
+    return magnitude_to_digits(magnitude, 10);
+}
+
+int64_t BigInt::to_int64() const
+{
+    if (!fits_in<int64_t>())
+    {
+        throw std::out_of_range("BigInt is out of the range of int64_t");
+    }
+    if (magnitude.empty())
+        return 0;
+    return (sign == '-') ? static_cast<int64_t>(0 - magnitude[0]) : static_cast<int64_t>(magnitude[0]); // 0 - magnitude wraps to the two's complement of -2^63 too
+}
+
+uint64_t BigInt::to_uint64() const
+{
+    if (!fits_in<uint64_t>())
+    {
+        throw std::out_of_range("BigInt is out of the range of uint64_t");
+    }
+    return magnitude.empty() ? 0 : magnitude[0];
+}
+
+double BigInt::to_double() const
+{
+    return to_floating<double>();
+}
+
+long double BigInt::to_long_double() const
+{
+    return to_floating<long double>();
+}
+
+double BigInt::frexp(int64_t &exponent) const
+{
+    return rounded_mantissa<double>(exponent);
+}
+
+template <typename T>
+bool BigInt::fits_in() const
+{
+    static_assert(std::is_arithmetic_v<T>, "fits_in needs an integer or floating-point type");
+
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        int64_t exponent;
+        rounded_mantissa<T>(exponent);
+        return exponent <= std::numeric_limits<T>::max_exponent;
+    }
+    else
+    {
+        if (magnitude.empty())
+            return true;
+        size_t bits = 64 * magnitude.size() - static_cast<size_t>(std::countl_zero(magnitude.back()));
+        const size_t digits = static_cast<size_t>(std::numeric_limits<T>::digits); // value bits without the sign bit
+        if (sign == '+')
+            return bits <= digits;
+        if (!std::is_signed_v<T>)
+            return false;
+        if (bits <= digits)
+            return true;
+        // the only negative value with digits + 1 bits that fits is -2^digits
+        if (bits != digits + 1 || (magnitude.back() & (magnitude.back() - 1)) != 0)
+            return false;
+        return std::all_of(magnitude.begin(), magnitude.end() - 1, [](limb value)
+                           { return value == 0; });
+    }
+}
+
+template <typename F>
+F BigInt::rounded_mantissa(int64_t &exponent) const
+{
+    constexpr int digits = std::numeric_limits<F>::digits;
+    static_assert(digits >= 2 && digits <= 126, "the mantissa must fit in two limbs with a rounding bit to spare");
+
+    exponent = 0;
+    if (magnitude.empty())
+        return F(0);
+
+    // the top 128 bits of the magnitude, left-aligned in (high, low)
+    size_t n = magnitude.size();
+    unsigned lead = static_cast<unsigned>(std::countl_zero(magnitude.back()));
+    auto limb_at = [&](size_t index_from_top) -> limb
+    { return (index_from_top < n) ? magnitude[n - 1 - index_from_top] : 0; };
+    limb high = limb_at(0), low = limb_at(1), next = limb_at(2);
+    if (lead != 0)
+    {
+        high = (high << lead) | (low >> (64 - lead));
+        low = (low << lead) | (next >> (64 - lead));
+    }
+    int64_t bits = static_cast<int64_t>(64 * n - lead);
+
+    // splits the window into the mantissa (the top digits bits), the rounding bit and the bits below it
+    constexpr unsigned shift = 128 - digits;
+    limb mantissa_high, mantissa_low, round_bit, below;
+    if constexpr (shift >= 64)
+    {
+        mantissa_high = 0;
+        mantissa_low = high >> (shift - 64);
+        round_bit = (shift == 64) ? (low >> 63) : ((high >> (shift - 65)) & 1);
+        below = (shift == 64) ? (low << 1) : (((shift == 65) ? 0 : (high << (129 - shift))) | low);
+    }
+    else
+    {
+        mantissa_high = high >> shift;
+        mantissa_low = (high << (64 - shift)) | (low >> shift);
+        round_bit = (low >> (shift - 1)) & 1;
+        below = low << (65 - shift);
+    }
+
+    if (round_bit != 0)
+    {
+        bool sticky = below != 0;
+        if (!sticky && bits > 128) // exactly halfway within the window, so the lower limbs decide
+        {
+            size_t below_window = static_cast<size_t>(bits - 128); // number of bits under the window
+            size_t full_limbs = below_window / 64;
+            unsigned partial = static_cast<unsigned>(below_window % 64);
+            sticky = partial != 0 && (magnitude[full_limbs] & ((limb{1} << partial) - 1)) != 0;
+            for (size_t i = 0; i < full_limbs && !sticky; ++i)
+                sticky = magnitude[i] != 0;
+        }
+        if (sticky || (mantissa_low & 1) != 0)
+        {
+            ++mantissa_low;
+            if (mantissa_low == 0)
+                ++mantissa_high;
+            bool overflow;
+            if constexpr (digits > 64)
+                overflow = (mantissa_high >> (digits - 64)) != 0;
+            else if constexpr (digits == 64)
+                overflow = mantissa_high != 0;
+            else
+                overflow = (mantissa_low >> digits) != 0;
+            if (overflow) // rounded up to the next power of two
+            {
+                exponent = bits + 1;
+                F one_half = F(0.5);
+                return (sign == '-') ? -one_half : one_half;
+            }
+        }
+    }
+
+    exponent = bits;
+    F mantissa = std::ldexp(std::ldexp(static_cast<F>(mantissa_high), 64) + static_cast<F>(mantissa_low), -digits);
+    return (sign == '-') ? -mantissa : mantissa;
+}
+
+template <typename F>
+F BigInt::to_floating() const
+{
+    int64_t exponent;
+    F mantissa = rounded_mantissa<F>(exponent);
+    if (exponent > std::numeric_limits<F>::max_exponent)
+        return (sign == '-') ? -std::numeric_limits<F>::infinity() : std::numeric_limits<F>::infinity();
+    return std::ldexp(mantissa, static_cast<int>(exponent));
+}
+
+std::string BigInt::to_string(unsigned base) const
+{
+    check_base(base);
+    std::string digits = magnitude_to_digits(magnitude, base);
+    if (sign == '-' && !magnitude.empty())
+        digits.insert(digits.begin(), '-');
+    return digits;
+}
+
+char BigInt::getsign() const
+{
+    return sign;
+}
+
+void BigInt::setsign(char ch)
+{
+    sign = ch;
+}
+
+void BigInt::setnumber(const std::string &str)
+{
+    size_t start_position = str.find_first_not_of('0'); // remove leading zeros before converting the digits
+    if (start_position == std::string::npos)
+    {
+        magnitude.clear();
+        return;
+    }
+
+    if (str.find_first_not_of("0123456789", start_position) != std::string::npos)
+    {
+        throw std::invalid_argument("Input contains invalid characters");
+    }
+
+    set_magnitude_from_digits(std::string_view(str).substr(start_position), 10);
+}
+
+size_t BigInt::decimal_digits(std::span<const limb> limbs)
+{
+    if (limbs.empty())
+        return 1;
+
+    if (limbs.size() == 1)
+    {
+        size_t digits = 1;
+        for (limb value = limbs[0]; value >= 10; value /= 10)
+            ++digits;
+        return digits;
+    }
+
+    // the lower limbs change the top two by less than one part in 2^64, far below the error of the double arithmetic
+    size_t size = limbs.size();
+    double top = std::ldexp(static_cast<double>(limbs[size - 1]), 64) + static_cast<double>(limbs[size - 2]);
+    double shift_bits = 64.0 * static_cast<double>(size - 2);
+    double logarithm = std::log10(top) + shift_bits * 0.30102999566398119521;
+    double margin = 1e-12 + shift_bits * 1e-15;
+    double nearest = std::round(logarithm);
+    if (std::fabs(logarithm - nearest) > margin)
+        return static_cast<size_t>(std::floor(logarithm)) + 1;
+
+    // value is close to 10^k, so one exact comparison decides between k and k + 1 digits
+    size_t exponent = static_cast<size_t>(nearest);
+    BigInt power = pow(BigInt(10), exponent);
+    return exponent + (compare_magnitude(limbs, power.magnitude) >= 0 ? 1 : 0);
+}
+
+size_t BigInt::getsize() const
+{
+    return decimal_digits(magnitude);
+}
+
+BigInt BigInt::abs() const
+{
+    BigInt temp = *this;
+    temp.setsign('+');
+    return temp;
+}
+
+int BigInt::compare_magnitude(std::span<const limb> left, std::span<const limb> right)
+{
+    if (left.size() != right.size())
+        return (left.size() > right.size()) ? 1 : -1;
+
+    for (size_t i = left.size(); i > 0; --i) // equal sizes, so the first differing limb from the top decides
+    {
+        if (left[i - 1] != right[i - 1])
+            return (left[i - 1] > right[i - 1]) ? 1 : -1;
+    }
+    return 0;
+}
+
+bool BigInt::operator==(const BigInt &operand) const
+{
+    if (magnitude.size() != operand.magnitude.size())
+        return false;
+
+    if (compare_magnitude(magnitude, operand.magnitude) != 0)
+        return false;
+
+    return sign == operand.sign || magnitude.empty(); // zero is equal to zero regardless of its sign
+}
+
+bool BigInt::operator!=(const BigInt &operand) const
+{
+    return !(*this == operand);
+}
+
+std::strong_ordering BigInt::compare(const BigIntView &left, const BigIntView &right)
+{
+    char left_sign = left.limbs.empty() ? '+' : left.sign;
+    char right_sign = right.limbs.empty() ? '+' : right.sign;
+
+    if (left_sign != right_sign)
+        return (left_sign == '+') ? std::strong_ordering::greater : std::strong_ordering::less;
+
+    std::strong_ordering result = compare_magnitude(left.limbs, right.limbs) <=> 0;
+
+    if (left_sign == '-') // for negative numbers the larger magnitude is the smaller number
+        return 0 <=> result;
+
+    return result;
+}
+
+std::strong_ordering BigInt::operator<=>(const BigInt &operand) const
+{
+    return compare(*this, operand);
+}
+
+bool BigInt::operator>(const BigInt &operand) const
+{
+    return (*this <=> operand) > 0;
+}
+
+bool BigInt::operator<(const BigInt &operand) const
+{
+    return (*this <=> operand) < 0;
+}
+
+bool BigInt::operator>=(const BigInt &operand) const
+{
+    return (*this <=> operand) >= 0;
+}
+
+bool BigInt::operator<=(const BigInt &operand) const
+{
+    return (*this <=> operand) <= 0;
+}
+
+size_t BigInt::hash() const
+{
+    std::string_view bytes(reinterpret_cast<const char *>(magnitude.data()), magnitude.size() * sizeof(limb));
+    size_t limbs_hash = std::hash<std::string_view>{}(bytes); // hashes the limbs in place without copying them
+    if (sign == '-' && !magnitude.empty())
+        limbs_hash ^= 0x9e3779b97f4a7c15ULL + (limbs_hash << 6) + (limbs_hash >> 2); // mixes the sign into the hash like boost::hash_combine
+    return limbs_hash;
+}
+
+void BigInt::add_signed(std::span<const limb> operand, char operand_sign)
+{
+    if (operand.empty())
+        return;
+
+    if (magnitude.empty())
+    {
+        magnitude.assign(operand.begin(), operand.end());
+        sign = operand_sign;
+        return;
+    }
+
+    size_t left_size = magnitude.size();
+    size_t right_size = operand.size();
+
+    if (sign == operand_sign) // equal signs, so the magnitudes are added and the sign is kept
+    {
+        if (left_size >= right_size)
+        {
+            std::span<limb> limbs(magnitude.data(), left_size);
+            limb carry = bigint_mpn::add(limbs, limbs, operand);
+            if (carry != 0)
+                magnitude.push_back(carry);
+        }
+        else
+        {
+            magnitude.resize(right_size);
+            limb carry = bigint_mpn::add(magnitude, operand, std::span<const limb>(magnitude).first(left_size));
+            if (carry != 0)
+                magnitude.push_back(carry);
+        }
+        return;
+    }
+
+    int order = compare_magnitude(std::as_const(magnitude), operand); // read through the const view, a shared magnitude is only copied once it is written
+    if (order == 0)
+    {
+        magnitude.clear();
+        sign = '+';
+        return;
+    }
+
+    if (order > 0) // |*this| > |operand|, so the sign of *this is kept
+    {
+        std::span<limb> limbs(magnitude.data(), left_size);
+        bigint_mpn::sub(limbs, limbs, operand);
+    }
+    else // |*this| < |operand|, so the result takes the sign of the operand
+    {
+        magnitude.resize(right_size);
+        bigint_mpn::sub(magnitude, operand, std::span<const limb>(magnitude).first(left_size));
+        sign = operand_sign;
+    }
+    trim();
+}
+
+BigInt BigInt::operator+(const BigInt &operand) const
+{
+    bigint_detail::stat_scope scope(BigIntOp::add, std::max(magnitude.size(), operand.magnitude.size()), BigIntTier::basecase);
+    BigInt result = *this;
+    result.add_signed(operand.magnitude, operand.sign);
+    return result;
+}
+
+BigInt &BigInt::operator+=(const BigInt &operand)
+{
+    bigint_detail::stat_scope scope(BigIntOp::add, std::max(magnitude.size(), operand.magnitude.size()), BigIntTier::basecase);
+    add_signed(operand.magnitude, operand.sign);
+    return *this;
+}
+
+BigInt BigInt::operator-(const BigInt &operand) const
+{
+    bigint_detail::stat_scope scope(BigIntOp::subtract, std::max(magnitude.size(), operand.magnitude.size()), BigIntTier::basecase);
+    BigInt result = *this;
+    result.add_signed(operand.magnitude, (operand.sign == '+') ? '-' : '+');
+    return result;
+}
+
+BigInt &BigInt::operator-=(const BigInt &operand)
+{
+    bigint_detail::stat_scope scope(BigIntOp::subtract, std::max(magnitude.size(), operand.magnitude.size()), BigIntTier::basecase);
+    add_signed(operand.magnitude, (operand.sign == '+') ? '-' : '+');
+    return *this;
+}
+
+BigInt BigInt::operator-() const
+{
+    BigInt negated = *this;
+
+    if (negated.getsign() == '+' && !negated.magnitude.empty()) // zero keeps its positive sign
+        negated.setsign('-');
+    else
+        negated.setsign('+');
+
+    return negated;
+}
+
+BigInt BigInt::multiply(const BigIntView &left, const BigIntView &right)
+{
+    bool square = left.limbs.data() == right.limbs.data() && left.limbs.size() == right.limbs.size();
+    bigint_detail::stat_scope scope(square ? BigIntOp::square : BigIntOp::multiply, std::max(left.limbs.size(), right.limbs.size()));
+    BigInt result;
+
+    if (left.limbs.empty() || right.limbs.empty())
+        return result;
+
+    result.magnitude.resize(left.limbs.size() + right.limbs.size());
+    if (square) // x * x is a square, which needs about half the work
+    {
+        std::vector<limb> scratch(bigint_mpn::sqr_scratch_size(left.limbs.size()));
+        bigint_mpn::sqr(result.magnitude, left.limbs, scratch);
+    }
+    else
+    {
+        std::vector<limb> scratch(bigint_mpn::mul_scratch_size(left.limbs.size(), right.limbs.size()));
+        bigint_mpn::mul(result.magnitude, left.limbs, right.limbs, scratch);
+    }
+
+    result.sign = (left.sign == right.sign) ? '+' : '-';
+    result.trim();
+
+    return result;
+}
+
+BigInt BigInt::operator*(const BigInt &operand) const
+{
+    return multiply(*this, operand);
+}
+
+void BigInt::setthreads(unsigned thread_count)
+{
+    bigint_detail::parallel_settings &settings = bigint_detail::parallel();
+    std::lock_guard<std::mutex> lock(settings.mutex);
+
+    if (thread_count == 0)
+        thread_count = std::max(1U, std::thread::hardware_concurrency()); // hardware_concurrency() may return 0 when it is unknown
+
+    settings.pool.reset();
+    settings.threads = thread_count;
+    if (thread_count > 1)
+        settings.pool = std::make_unique<bigint_detail::thread_pool>(thread_count - 1); // the calling thread is the last one
+}
+
+unsigned BigInt::getthreads()
+{
+    return bigint_detail::parallel().threads;
+}
+
+void BigInt::setgrainsize(size_t limbs)
+{
+    bigint_detail::parallel_settings &settings = bigint_detail::parallel();
+    std::lock_guard<std::mutex> lock(settings.mutex);
+    settings.grain = std::max<size_t>(limbs, bigint_detail::karatsuba_threshold);
+}
+
+size_t BigInt::getgrainsize()
+{
+    return bigint_detail::parallel().grain;
+}
+
+BigIntStats BigInt::getstats()
+{
+    BigIntStats snapshot;
+#if defined(BIGINT_INSTRUMENTATION)
+    const bigint_detail::stats_registry &registry = bigint_detail::stats();
+    for (size_t op = 0; op < BigIntStats::op_count; ++op)
+    {
+        for (size_t bucket = 0; bucket < BigIntStats::bucket_count; ++bucket)
+            snapshot.calls[op][bucket] = registry.calls[op][bucket].load(std::memory_order_relaxed);
+        for (size_t tier = 0; tier < BigIntStats::tier_count; ++tier)
+            snapshot.tiers[op][tier] = registry.tiers[op][tier].load(std::memory_order_relaxed);
+        snapshot.nanoseconds[op] = registry.nanoseconds[op].load(std::memory_order_relaxed);
+        snapshot.bytes[op] = registry.bytes[op].load(std::memory_order_relaxed);
+    }
+    snapshot.bytes_allocated = registry.bytes_allocated.load(std::memory_order_relaxed);
+    snapshot.allocations = registry.allocations.load(std::memory_order_relaxed);
+#endif
+    return snapshot;
+}
+
+void BigInt::resetstats()
+{
+#if defined(BIGINT_INSTRUMENTATION)
+    bigint_detail::stats_registry &registry = bigint_detail::stats();
+    for (size_t op = 0; op < BigIntStats::op_count; ++op)
+    {
+        for (std::atomic<uint64_t> &count : registry.calls[op])
+            count.store(0, std::memory_order_relaxed);
+        for (std::atomic<uint64_t> &count : registry.tiers[op])
+            count.store(0, std::memory_order_relaxed);
+        registry.nanoseconds[op].store(0, std::memory_order_relaxed);
+        registry.bytes[op].store(0, std::memory_order_relaxed);
+    }
+    registry.bytes_allocated.store(0, std::memory_order_relaxed);
+    registry.allocations.store(0, std::memory_order_relaxed);
+#endif
+}
+
+void BigInt::setstatshook([[maybe_unused]] std::function<void(const BigIntEvent &)> hook)
+{
+#if defined(BIGINT_INSTRUMENTATION)
+    bigint_detail::stats().hook = std::move(hook);
+#endif
+}
+
+BigInt &BigInt::operator*=(const BigInt &operand)
+{
+    *this = *this * operand;
+    return *this;
+}
+
+BigInt &BigInt::operator++()
+{
+    bigint_detail::stat_scope scope(BigIntOp::add, magnitude.size(), BigIntTier::basecase);
+    const limb one = 1;
+    add_signed(std::span<const limb>(&one, 1), '+');
+    return *this;
+}
+
+BigInt BigInt::operator++(int)
+{
+    BigInt result = *this;
+    ++*this;
+    return result;
+}
+
+BigInt &BigInt::operator--()
+{
+    bigint_detail::stat_scope scope(BigIntOp::subtract, magnitude.size(), BigIntTier::basecase);
+    const limb one = 1;
+    add_signed(std::span<const limb>(&one, 1), '-');
+    return *this;
+}
+
+BigInt BigInt::operator--(int)
+{
+    BigInt result = *this;
+    --*this;
+    return result;
+}
+
+std::ostream &operator<<(std::ostream &out, const BigInt &bigint)
+{
+    if (bigint.getsign() == '+')
+        out << "+" << bigint.getnumber();
+    else if (bigint.getsign() == '-')
+        out << "-" << bigint.getnumber();
+    return out;
+}
+
+BigInt::radix_parser::radix_parser(unsigned base_value) : base(base_value), base_twos(static_cast<unsigned>(std::countr_zero(base_value))), odd_base(base_value >> std::countr_zero(base_value))
+{
+    unsigned chunk_digits;
+    chunk_scale(base, chunk_digits);
+    block_digits = 32 * std::size_t{chunk_digits};
+    block.reserve(block_digits);
+}
+
+void BigInt::radix_parser::push(const char *digits, size_t count)
+{
+    while (count > 0)
+    {
+        size_t length = std::min(count, block_digits - block.size());
+        block.append(digits, length);
+        digits += length;
+        count -= length;
+        if (block.size() < block_digits)
+            return;
+
+        segment leaf{BigInt(), 0};
+        leaf.value.set_magnitude_from_digits(block, base);
+        block.clear();
+        stack.push_back(std::move(leaf));
+        ++blocks;
+
+        while (stack.size() >= 2 && stack[stack.size() - 2].level == stack.back().level) // merges equal neighbours like a binary counter
+        {
+            if (stack.size() == 2) // the carry into the oldest segment, everything read so far becomes one value
+            {
+                size_t level = stack[0].level + 1;
+                BigInt whole = fold(BigInt(), 0);
+                stack.push_back({std::move(whole), level});
+                break;
+            }
+            size_t total = 0;
+            for (const segment &part : stack)
+                total += part.value.magnitude.size();
+            BigInt low = std::move(stack.back().value);
+            stack.pop_back();
+            segment &high = stack.back();
+            const BigInt &odd = power(high.level);
+            if (4 * high.value.magnitude.size() >= total) // the smaller powers are rebuilt cheaply, next to this product and its scratch they would be the largest thing left
+                for (size_t level = 0; level < high.level; ++level)
+                    powers[level] = BigInt();
+            merge(high.value, odd, power_shift(high.level), std::move(low));
+            ++high.level;
+        }
+    }
+}
+
+BigInt BigInt::radix_parser::finish()
+{
+    // the digits of the partial block are the least significant ones
+    BigInt partial;
+    partial.set_magnitude_from_digits(block, base);
+    BigInt result;
+    if (stack.empty())
+        result = std::move(partial);
+    else if (stack.size() == 1 && block.empty())
+        result = std::move(stack[0].value);
+    else
+        result = fold(std::move(partial), block.size());
+    stack.clear();
+    powers.clear();
+    block.clear();
+    blocks = 0;
+    return result;
+}
+
+const BigInt &BigInt::radix_parser::power(size_t level)
+{
+    if (powers.size() <= level)
+        powers.resize(level + 1);
+    if (powers[level].magnitude.empty())
+    {
+        if (level == 0)
+            powers[0] = odd_power(block_digits);
+        else
+        {
+            const BigInt &half = power(level - 1);
+            powers[level] = half * half;
+        }
+    }
+    return powers[level];
+}
+
+size_t BigInt::radix_parser::power_shift(size_t level) const
+{
+    return (base_twos * block_digits) << level;
+}
+
+BigInt BigInt::radix_parser::odd_power(size_t exponent) const
+{
+    unsigned chunk_digits;
+    chunk_scale(base, chunk_digits);
+    limb full_scale = 1;
+    for (unsigned i = 0; i < chunk_digits; ++i)
+        full_scale *= odd_base; // odd_base^chunk_digits <= base^chunk_digits, which fits in a limb
+    BigInt result(1);
+    for (; exponent > 0; exponent -= std::min<size_t>(exponent, chunk_digits))
+    {
+        limb scale = full_scale;
+        if (exponent < chunk_digits)
+        {
+            scale = 1;
+            for (size_t i = 0; i < exponent; ++i)
+                scale *= odd_base;
+        }
+        limb carry = bigint_detail::kernels().mul_1(result.magnitude.data(), result.magnitude.data(), result.magnitude.size(), scale);
+        if (carry != 0)
+            result.magnitude.push_back(carry);
+    }
+    return result;
+}
+
+/**
+ * @brief Empties the stack into one value, followed by partial which holds the last partial_digits digits
+ * The result buffer is allocated once at its final size and the oldest segment is copied into it and released, then each younger segment in turn is copied below the value and released before its power is built and multiply_add() runs
+ * Only the largest cached power the first step can use is kept while the buffer is allocated, and each step drops the powers below its own, which are rebuilt for later merges when they need them
+ */
+
+BigInt BigInt::radix_parser::fold(BigInt partial, size_t partial_digits)
+{
+    size_t digits = blocks * block_digits + partial_digits;
+    size_t capacity = static_cast<size_t>(static_cast<double>(digits) * std::log2(static_cast<double>(base)) / 64) + 8; // the value is below base^digits, and each step needs a few limbs of room above it
+    size_t piece = std::max(capacity / fold_pieces, bigint_detail::karatsuba_threshold);
+    powers.resize(std::min(powers.size(), (stack.size() > 1) ? stack[1].level + 1 : 0));
+    while (!powers.empty() && powers.back().magnitude.empty())
+        powers.pop_back();
+    for (size_t level = 0; level + 1 < powers.size(); ++level)
+        powers[level] = BigInt();
+
+    BigInt result;
+    result.magnitude.resize(capacity);
+    limb *rp = result.magnitude.data();
+    size_t size = stack[0].value.magnitude.size();
+    std::copy(stack[0].value.magnitude.begin(), stack[0].value.magnitude.end(), rp);
+    stack[0].value = BigInt();
+
+    // moves the value up by room limbs, past the longest odd part of base^exponent and the shift, and puts low below it
+    auto place = [&](BigInt low, size_t exponent)
+    {
+        size_t room = static_cast<size_t>(static_cast<double>(exponent) * std::log2(static_cast<double>(odd_base)) / 64) + base_twos * exponent / 64 + 4;
+        std::copy_backward(rp, rp + size, rp + room + size);
+        std::copy(low.magnitude.begin(), low.magnitude.end(), rp);
+        std::fill(rp + low.magnitude.size(), rp + room, 0);
+        return room;
+    };
+    for (size_t i = 1; i < stack.size(); ++i)
+    {
+        size_t level = stack[i].level;
+        size_t room = place(std::move(stack[i].value), block_digits << level);
+        const BigInt &odd = power(level);
+        for (size_t smaller = 0; smaller < level; ++smaller)
+            powers[smaller] = BigInt();
+        multiply_add(rp, size, room, piece, odd.magnitude, power_shift(level));
+        powers.resize(level);
+    }
+    stack.clear();
+    if (partial_digits > 0)
+    {
+        size_t room = place(std::move(partial), partial_digits);
+        multiply_add(rp, size, room, piece, odd_power(partial_digits).magnitude, base_twos * partial_digits);
+    }
+    result.magnitude.resize(size);
+    return result;
+}
+
+/**
+ * @brief Sets the value at rp + room, size limbs long, to value * odd * 2^shift + low in place, where low < odd * 2^shift fills the room limbs below it, and sets size to the length of the result
+ * room must exceed the length of odd * 2^shift by a limb, and the pieces of the value are multiplied from the least significant one up, each copied out and cleared first
+ * A product lands below the top of its own piece, and the sum so far is less than 2^64 to the power of that top minus one, so no carry reaches a piece that is still to be read
+ */
+
+void BigInt::radix_parser::multiply_add(limb *rp, size_t &size, size_t room, size_t piece, std::span<const limb> odd, size_t shift)
+{
+    size_t limb_shift = shift / 64;
+    unsigned bit_shift = static_cast<unsigned>(shift % 64);
+    auto balanced = [piece](size_t length)
+    {
+        size_t count = (length + piece - 1) / piece;
+        return (count > 1) ? (length + count - 1) / count : length;
+    };
+    size_t a_piece = balanced(size), b_piece = balanced(odd.size());
+    std::vector<limb> saved(a_piece), product(a_piece + b_piece + 1), scratch;
+    for (size_t begin = 0; begin < size; begin += a_piece)
+    {
+        size_t length = std::min(a_piece, size - begin), top = room + begin + length;
+        std::copy(rp + room + begin, rp + top, saved.data());
+        std::fill(rp + room + begin, rp + top, 0);
+        for (size_t j = 0; j < odd.size(); j += b_piece)
+        {
+            std::span<const limb> a(saved.data(), length), b = odd.subspan(j, std::min(b_piece, odd.size() - j));
+            if (a.size() < b.size())
+                std::swap(a, b);
+            size_t product_size = a.size() + b.size();
+            scratch.resize(std::max(scratch.size(), bigint_detail::mul_scratch_size(a.size(), b.size())));
+            bigint_detail::mul(product.data(), a.data(), a.size(), b.data(), b.size(), scratch.data());
+            product[product_size] = (bit_shift != 0) ? bigint_detail::lshift(product.data(), product.data(), product_size, bit_shift) : 0;
+            size_t offset = begin + j + limb_shift;
+            bigint_detail::add(rp + offset, rp + offset, top - offset, product.data(), product_size + 1);
+        }
+    }
+    for (size += room; size > 0 && rp[size - 1] == 0; --size)
+        ;
+}
+
+/**
+ * @brief Sets high to high * odd * 2^shift + low, where low < odd * 2^shift, writing the product straight into the limbs of the result and adding low afterwards
+ */
+
+void BigInt::radix_parser::merge(BigInt &high, const BigInt &odd, size_t shift, BigInt low)
+{
+    if (high.magnitude.empty()) // only leading zeros so far
+    {
+        high = std::move(low);
+        return;
+    }
+
+    std::span<const limb> left = high.magnitude, right = odd.magnitude;
+    if (left.size() < right.size())
+        std::swap(left, right);
+    size_t limb_shift = shift / 64;
+    unsigned bit_shift = static_cast<unsigned>(shift % 64);
+    size_t size = left.size() + right.size() + limb_shift + 1;
+
+    BigInt result;
+    result.magnitude.resize(size);
+    limb *rp = result.magnitude.data();
+    std::vector<limb> scratch(bigint_detail::mul_scratch_size(left.size(), right.size()));
+    size_t product_size = left.size() + right.size();
+    bigint_detail::mul(rp + limb_shift, left.data(), left.size(), right.data(), right.size(), scratch.data());
+    if (bit_shift != 0)
+        rp[limb_shift + product_size] = bigint_detail::lshift(rp + limb_shift, rp + limb_shift, product_size, bit_shift);
+    bigint_detail::add(rp, rp, size, low.magnitude.data(), low.magnitude.size());
+    result.trim();
+    high = std::move(result);
+}
+
+BigInt::radix_printer::radix_printer(unsigned base_value) : base(base_value)
+{
+}
+
+std::string BigInt::radix_printer::print(std::span<const limb> limbs)
+{
+    BigInt value;
+    value.magnitude.assign(limbs.begin(), limbs.end());
+
+    // finds the smallest level with value < P(level), without computing a power much larger than the value
+    size_t level = 0;
+    bigint_detail::task_step(0.1, [&]
+                             {
+                                 while (compare_magnitude(value.magnitude, get(level).value.magnitude) >= 0)
+                                 {
+                                     size_t size = get(level).value.magnitude.size();
+                                     ++level;
+                                     if (2 * size - 1 > value.magnitude.size()) // the next power has at least 2 size - 1 limbs, so it is larger than the value
+                                         break;
+                                 } });
+
+    std::string out;
+    bigint_detail::task_step(1, [&]
+                             { write(out, value, level, false); });
+    return out;
+}
+
+BigInt::radix_printer::power &BigInt::radix_printer::get(size_t level)
+{
+    while (powers.size() <= level)
+    {
+        power next;
+        if (powers.empty())
+        {
+            unsigned chunk_digits;
+            next.value.magnitude.assign(1, chunk_scale(base, chunk_digits));
+            next.digits = chunk_digits;
+        }
+        else
+        {
+            next.value = powers.back().value * powers.back().value;
+            next.digits = 2 * powers.back().digits;
+        }
+        next.shift = static_cast<unsigned>(std::countl_zero(next.value.magnitude.back()));
+        next.normalized = shift_left(next.value, next.shift);
+        powers.push_back(std::move(next));
+    }
+    return powers[level];
+}
+
+void BigInt::radix_printer::write(std::string &out, const BigInt &value, size_t level, bool pad)
+{
+    size_t width = pad ? get(level).digits : 0; // numbers below P(level) have at most that many digits
+    if (level == 0 || value.magnitude.size() <= threshold)
+    {
+        append_digits(out, value.magnitude, base, width);
+        return;
+    }
+
+    // every level of the recursion costs about the same, so this division is one of level + 1 equal parts and the halves share the rest
+    BigInt quotient, remainder;
+    bigint_detail::task_step(1.0 / static_cast<double>(level + 1), [&]
+                             { divide(value, get(level - 1), quotient, remainder); });
+    if (!pad && quotient.magnitude.empty()) // the leading part of the number has no high half
+    {
+        bigint_detail::task_step(1, [&]
+                                 { write(out, remainder, level - 1, false); });
+        return;
+    }
+    double half = static_cast<double>(level) / static_cast<double>(2 * (level + 1));
+    bigint_detail::task_step(half, [&]
+                             { write(out, quotient, level - 1, pad); });
+    bigint_detail::task_step(half, [&]
+                             { write(out, remainder, level - 1, true); });
+}
+
+void BigInt::radix_printer::divide(const BigInt &dividend, power &divisor, BigInt &quotient, BigInt &remainder)
+{
+    if (divisor.reciprocal.magnitude.empty())
+        divisor.reciprocal = reciprocal(divisor.normalized);
+
+    // the dividend is below P^2, so the scaled dividend is below normalized * B^L and the estimate is at most two too small
+    size_t size = divisor.normalized.magnitude.size();
+    BigInt scaled = shift_left(dividend, divisor.shift);
+    quotient = shift_right(scaled * divisor.reciprocal, 128 * size);
+    remainder = scaled - quotient * divisor.normalized;
+    while (remainder >= divisor.normalized)
+    {
+        remainder -= divisor.normalized;
+        ++quotient;
+    }
+    remainder = shift_right(remainder, divisor.shift);
+}
+
+BigInt BigInt::radix_printer::reciprocal(const BigInt &divisor)
+{
+    size_t size = divisor.magnitude.size();
+    BigInt all_ones; // B^(2 size) - 1
+    all_ones.magnitude.assign(2 * size, ~limb{0});
+
+    if (size <= threshold)
+    {
+        BigInt result;
+        bigint_detail::limb_buffer remainder;
+        divide_magnitude(all_ones.magnitude, divisor.magnitude, result.magnitude, remainder);
+        result.trim();
+        return result;
+    }
+
+    // the reciprocal v of the high half, refined by one Newton step v + v (B^(2 size) - d v) / B^(2 size) and then corrected exactly
+    size_t half = (size + 1) / 2;
+    BigInt high;
+    high.magnitude.assign(divisor.magnitude.end() - static_cast<std::ptrdiff_t>(half), divisor.magnitude.end());
+    BigInt high_reciprocal = reciprocal(high);
+
+    BigInt error = all_ones + BigInt(1) - shift_left(divisor * high_reciprocal, 64 * (size - half));
+    BigInt result = shift_left(high_reciprocal, 64 * (size - half)) + shift_right(high_reciprocal * error, 64 * (size + half));
+
+    BigInt remainder = all_ones - divisor * result;
+    while (remainder.sign == '-')
+    {
+        --result;
+        remainder += divisor;
+    }
+    while (remainder >= divisor)
+    {
+        ++result;
+        remainder -= divisor;
+    }
+    return result;
+}
+
+BigInt BigInt::radix_printer::shift_left(const BigInt &value, size_t bits)
+{
+    BigInt result;
+    if (value.magnitude.empty())
+        return result;
+    size_t limbs = bits / 64;
+    unsigned count = static_cast<unsigned>(bits % 64);
+    result.magnitude.reserve(limbs + value.magnitude.size() + 1);
+    result.magnitude.resize(limbs + value.magnitude.size());
+    std::copy(value.magnitude.begin(), value.magnitude.end(), result.magnitude.begin() + static_cast<std::ptrdiff_t>(limbs));
+    if (count != 0)
+    {
+        limb out = bigint_detail::lshift(result.magnitude.data() + limbs, result.magnitude.data() + limbs, value.magnitude.size(), count);
+        if (out != 0)
+            result.magnitude.push_back(out);
+    }
+    result.sign = value.sign;
+    return result;
+}
+
+BigInt BigInt::radix_printer::shift_right(const BigInt &value, size_t bits)
+{
+    BigInt result;
+    size_t limbs = bits / 64;
+    if (limbs >= value.magnitude.size())
+        return result;
+    unsigned count = static_cast<unsigned>(bits % 64);
+    result.magnitude.assign(value.magnitude.begin() + static_cast<std::ptrdiff_t>(limbs), value.magnitude.end());
+    if (count != 0)
+        bigint_detail::rshift(result.magnitude.data(), result.magnitude.data(), result.magnitude.size(), count);
+    result.sign = value.sign;
+    result.trim();
+    return result;
+}
+
+std::istream &operator>>(std::istream &in, BigInt &bigint)
+{
+    std::istream::sentry sentry(in); // skips leading whitespace
+    if (!sentry)
+        return in;
+
+    using traits = std::istream::traits_type;
+    std::streambuf *buffer = in.rdbuf();
+    std::ios_base::iostate state = std::ios_base::goodbit;
+    traits::int_type next = buffer->sgetc();
+
+    char sign = '+';
+    if (next == traits::to_int_type('+') || next == traits::to_int_type('-'))
+    {
+        sign = traits::to_char_type(next);
+        next = buffer->snextc();
+    }
+
+    bigint_detail::stat_scope scope(BigIntOp::parse, 0, BigIntTier::divide_and_conquer);
+    BigInt::radix_parser parser(10);
+    char chunk[4096];
+    size_t chunk_size = 0;
+    bool any_digit = false;
+    while (!traits::eq_int_type(next, traits::eof()) && std::isdigit(next))
+    {
+        chunk[chunk_size++] = traits::to_char_type(next);
+        if (chunk_size == sizeof(chunk))
+        {
+            parser.push(chunk, chunk_size);
+            chunk_size = 0;
+        }
+        any_digit = true;
+        next = buffer->snextc();
+    }
+    if (traits::eq_int_type(next, traits::eof()))
+        state |= std::ios_base::eofbit;
+
+    if (!any_digit)
+    {
+        in.setstate(state | std::ios_base::failbit);
+        return in;
+    }
+
+    parser.push(chunk, chunk_size);
+    bigint = parser.finish();
+    bigint.sign = sign;
+    bigint.trim();
+    scope.set_limbs(bigint.magnitude.size());
+
+    in.setstate(state);
+    return in;
+}
+
+#if defined(BIGINT_HAS_FD_INPUT)
+BigInt BigInt::from_fd(int fd)
+{
+    enum class stage
+    {
+        leading_space,
+        sign,
+        digits,
+        trailing_space
+    };
+
+    stage current = stage::leading_space;
+    char sign_char = '+';
+    bool any_digit = false;
+    bigint_detail::stat_scope scope(BigIntOp::parse, 0, BigIntTier::divide_and_conquer);
+    radix_parser parser(10);
+    std::vector<char> buffer(1 << 16);
+
+    while (true)
+    {
+        ssize_t count = ::read(fd, buffer.data(), buffer.size());
+        if (count < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw std::system_error(errno, std::generic_category(), "Could not read the input");
+        }
+        if (count == 0)
+            break;
+
+        const char *position = buffer.data();
+        const char *end = position + count;
+        while (position != end)
+        {
+            unsigned char c = static_cast<unsigned char>(*position);
+            if (current == stage::leading_space && std::isspace(c))
+            {
+                ++position;
+                continue;
+            }
+            if (current == stage::leading_space)
+            {
+                current = stage::sign;
+                if (c == '+' || c == '-')
+                {
+                    sign_char = static_cast<char>(c);
+                    ++position;
+                    continue;
+                }
+            }
+            if (current == stage::sign || current == stage::digits)
+            {
+                const char *run_end = position;
+                while (run_end != end && std::isdigit(static_cast<unsigned char>(*run_end)))
+                    ++run_end;
+                if (run_end != position) // pushes the whole run of digits at once
+                {
+                    parser.push(position, static_cast<size_t>(run_end - position));
+                    any_digit = true;
+                    current = stage::digits;
+                    position = run_end;
+                    continue;
+                }
+                current = stage::trailing_space;
+            }
+            if (!std::isspace(c) || !any_digit)
+                throw std::invalid_argument("Input contains invalid characters");
+            ++position;
+        }
+    }
+
+    if (current == stage::leading_space)
+        throw std::invalid_argument("Input is empty ");
+    if (!any_digit)
+        throw std::invalid_argument("Input contains invalid characters");
+
+    BigInt result = parser.finish();
+    result.sign = sign_char;
+    result.trim();
+    scope.set_limbs(result.magnitude.size());
+    return result;
+}
+#endif
+
+void BigInt::divide_magnitude(std::span<const limb> dividend, std::span<const limb> divisor, bigint_detail::limb_buffer &quotient, bigint_detail::limb_buffer &remainder)
+{
+    if (compare_magnitude(dividend, divisor) < 0)
+    {
+        quotient.clear();
+        remainder.assign(dividend.begin(), dividend.end());
+        return;
+    }
+
+    if (divisor.size() == 1)
+    {
+        bigint_detail::note_tier(BigIntTier::single_limb);
+        quotient.resize(dividend.size());
+        limb rem = bigint_mpn::divrem_1(quotient, dividend, divisor[0]);
+        remainder.clear();
+        if (rem != 0)
+            remainder.push_back(rem);
+    }
+    else
+    {
+        bigint_detail::note_tier(BigIntTier::basecase);
+        quotient.resize(dividend.size() - divisor.size() + 1);
+        remainder.resize(divisor.size());
+        std::vector<limb> scratch(bigint_mpn::divrem_scratch_size(dividend.size(), divisor.size()));
+        bigint_mpn::divrem(quotient, remainder, dividend, divisor, scratch);
+        while (!remainder.empty() && remainder.back() == 0)
+            remainder.pop_back();
+    }
+
+    while (!quotient.empty() && quotient.back() == 0)
+        quotient.pop_back();
+}
+
+BigInt BigInt::divide(const BigIntView &dividend, const BigIntView &divisor)
+{
+    bigint_detail::stat_scope scope(BigIntOp::divide, std::max(dividend.limbs.size(), divisor.limbs.size()));
+    if (divisor.limbs.empty())
+    {
+        throw std::invalid_argument("Division by zero is not allowed");
+    }
+
+    BigInt quotient;
+    bigint_detail::limb_buffer remainder;
+    divide_magnitude(dividend.limbs, divisor.limbs, quotient.magnitude, remainder);
+
+    quotient.sign = (dividend.sign == divisor.sign) ? '+' : '-';
+    quotient.trim();
+
+    return quotient;
+}
+
+BigInt BigInt::operator/(const BigInt &operand) const
+{
+    return divide(*this, operand);
+}
+
+BigInt &BigInt::operator/=(const BigInt &operand)
+{
+
+    *this = *this / operand;
+
+    return *this;
+}
+
+BigInt BigInt::modulo(const BigIntView &dividend, const BigIntView &divisor)
+{
+    bigint_detail::stat_scope scope(BigIntOp::modulo, std::max(dividend.limbs.size(), divisor.limbs.size()));
+    if (divisor.limbs.empty())
+    {
+        throw std::invalid_argument("Division by zero is not allowed");
+    }
+
+    BigInt modulus;
+    bigint_detail::limb_buffer quotient;
+    divide_magnitude(dividend.limbs, divisor.limbs, quotient, modulus.magnitude);
+
+    if (dividend.sign == '-' && !modulus.magnitude.empty())
+    {
+        // following the standard mathematical convention to ensure the modulus is non-negative: (-a) mod b = |b| - (a mod |b|)
+        bigint_detail::limb_buffer adjusted;
+        adjusted.resize(divisor.limbs.size());
+        bigint_mpn::sub(adjusted, divisor.limbs, modulus.magnitude);
+        modulus.magnitude = std::move(adjusted);
+    }
+
+    modulus.trim();
+    return modulus;
+}
+
+BigInt BigInt::divexact(const BigIntView &dividend, const BigIntView &divisor)
+{
+    bigint_detail::stat_scope scope(BigIntOp::divexact, std::max(dividend.limbs.size(), divisor.limbs.size()));
+    if (divisor.limbs.empty())
+    {
+        throw std::invalid_argument("Division by zero is not allowed");
+    }
+
+    // the factor 2^k of the divisor is divided out with shifts, so that the Hensel division sees an odd divisor
+    std::span<const limb> left = dividend.limbs, right = divisor.limbs;
+    size_t zero_limbs = 0;
+    while (right[zero_limbs] == 0)
+        ++zero_limbs;
+    left = left.subspan(std::min(zero_limbs, left.size()));
+    right = right.subspan(zero_limbs);
+
+    std::vector<limb> left_shifted, right_shifted;
+    unsigned shift = static_cast<unsigned>(std::countr_zero(right[0]));
+    if (shift != 0 && !left.empty())
+    {
+        left_shifted.resize(left.size());
+        right_shifted.resize(right.size());
+        bigint_mpn::rshift(left_shifted, left, shift);
+        bigint_mpn::rshift(right_shifted, right, shift);
+        left = std::span<const limb>(left_shifted).first(bigint_mpn::normalized_size(left_shifted));
+        right = std::span<const limb>(right_shifted).first(bigint_mpn::normalized_size(right_shifted));
+    }
+
+    BigInt quotient;
+    if (left.size() < right.size())
+        return quotient;
+
+    if (right.size() == 1)
+    {
+        bigint_detail::note_tier(BigIntTier::single_limb);
+        quotient.magnitude.resize(left.size());
+        bigint_detail::divexact_1(quotient.magnitude.data(), left.data(), left.size(), right[0]);
+    }
+    else if (std::min(left.size() - right.size() + 1, right.size()) < bigint_detail::hensel_blockwise_threshold)
+    {
+        bigint_detail::note_tier(BigIntTier::basecase);
+        quotient.magnitude.resize(left.size() - right.size() + 1);
+        std::vector<limb> scratch(quotient.magnitude.size());
+        bigint_detail::divexact(quotient.magnitude.data(), left.data(), left.size(), right.data(), right.size(), scratch.data());
+    }
+    else
+    {
+        bigint_detail::note_tier(BigIntTier::karatsuba);
+        quotient.magnitude.resize(left.size() - right.size() + 1);
+        bigint_detail::hensel_blockwise(left.data(), left.size(), right.data(), right.size(), quotient.magnitude.data());
+    }
+
+    quotient.sign = (dividend.sign == divisor.sign) ? '+' : '-';
+    quotient.trim();
+    return quotient;
+}
+
+bool BigInt::divisible_by_word(const BigIntView &dividend, uint64_t divisor)
+{
+    if (dividend.limbs.empty())
+        return true;
+    if (divisor == 0)
+        return false;
+
+    // 2^k and the odd part of the divisor are coprime, so both must divide the dividend
+    unsigned shift = static_cast<unsigned>(std::countr_zero(divisor));
+    if ((dividend.limbs[0] & ((1ULL << shift) - 1)) != 0)
+        return false;
+    divisor >>= shift;
+    return divisor == 1 || bigint_detail::modexact_1_odd(dividend.limbs.data(), dividend.limbs.size(), divisor) == 0;
+}
+
+bool BigInt::divisible_by(const BigIntView &dividend, const BigIntView &divisor)
+{
+    if (dividend.limbs.empty())
+        return true;
+    if (divisor.limbs.empty())
+        return false;
+    if (divisor.limbs.size() == 1)
+        return divisible_by_word(dividend, divisor.limbs[0]);
+
+    std::span<const limb> left = dividend.limbs, right = divisor.limbs;
+    size_t zero_limbs = 0;
+    while (right[zero_limbs] == 0)
+        ++zero_limbs;
+    if (zero_limbs >= left.size() || std::any_of(left.begin(), left.begin() + static_cast<std::ptrdiff_t>(zero_limbs), [](limb x)
+                                                  { return x != 0; }))
+        return false;
+    left = left.subspan(zero_limbs);
+    right = right.subspan(zero_limbs);
+
+    // as in divisible_by_word, the power of two is checked on the low bits and only the odd part of the divisor is divided
+    unsigned shift = static_cast<unsigned>(std::countr_zero(right[0]));
+    if ((left[0] & ((1ULL << shift) - 1)) != 0)
+        return false;
+    std::vector<limb> right_shifted;
+    if (shift != 0)
+    {
+        right_shifted.resize(right.size());
+        bigint_mpn::rshift(right_shifted, right, shift);
+        right = std::span<const limb>(right_shifted).first(bigint_mpn::normalized_size(right_shifted));
+    }
+
+    if (right.size() == 1)
+        return right[0] == 1 || bigint_detail::modexact_1_odd(left.data(), left.size(), right[0]) == 0;
+    if (left.size() < right.size())
+        return false;
+
+    size_t quotient_size = left.size() - right.size() + 1;
+    if (std::min(quotient_size, right.size()) < bigint_detail::hensel_blockwise_threshold)
+    {
+        std::vector<limb> scratch(left.size());
+        return bigint_detail::divisible(left.data(), left.size(), right.data(), right.size(), scratch.data());
+    }
+
+    return bigint_detail::hensel_blockwise(left.data(), left.size(), right.data(), right.size());
+}
+
+BigInt BigInt::gcd(const BigIntView &left, const BigIntView &right)
+{
+    bigint_detail::stat_scope scope(BigIntOp::gcd, std::max(left.limbs.size(), right.limbs.size()), BigIntTier::basecase);
+    BigInt result;
+    std::vector<limb> divisor = bigint_detail::gcd(std::vector<limb>(left.limbs.begin(), left.limbs.end()), std::vector<limb>(right.limbs.begin(), right.limbs.end()));
+    result.magnitude.assign(divisor.begin(), divisor.end());
+    return result;
+}
+
+BigInt BigInt::operator%(const BigInt &operand) const
+{
+    return modulo(*this, operand);
+}
+
+BigInt &BigInt::operator%=(const BigInt &operand)
+{
+
+    *this = *this % operand;
+
+    return *this;
+}
+
+void BigInt::assign_two_limbs(limb low, limb high, bool negative)
+{
+    magnitude.clear();
+    if (low != 0 || high != 0)
+        magnitude.push_back(low);
+    if (high != 0)
+        magnitude.push_back(high);
+    sign = (negative && !magnitude.empty()) ? '-' : '+';
+}
+
+struct BigInt::batch_block
+{
+    static constexpr size_t capacity = 256;
+
+    limb left[capacity];
+    limb right[capacity];
+    unsigned char left_negative[capacity];
+    unsigned char right_negative[capacity];
+    size_t size = 0;
+
+    /**
+     * @brief Copies the operands [begin, end) into the block and returns false if one of them needs more than one limb
+     */
+
+    bool gather(std::span<const BigInt> left_operands, std::span<const BigInt> right_operands, size_t begin, size_t end)
+    {
+        size = end - begin;
+        for (size_t i = 0; i < size; ++i)
+        {
+            const BigInt &x = left_operands[begin + i];
+            const BigInt &y = right_operands[begin + i];
+            if (x.magnitude.size() > 1 || y.magnitude.size() > 1)
+                return false;
+            left[i] = x.magnitude.empty() ? 0 : x.magnitude[0];
+            right[i] = y.magnitude.empty() ? 0 : y.magnitude[0];
+            left_negative[i] = (x.sign == '-' && left[i] != 0) ? 1 : 0;
+            right_negative[i] = (y.sign == '-' && right[i] != 0) ? 1 : 0;
+        }
+        return true;
+    }
+};
+
+void BigInt::check_batch_sizes(size_t left, size_t right, size_t result)
+{
+    if (left != right || left != result)
+    {
+        throw std::invalid_argument("Batch spans must have the same size");
+    }
+}
+
+void BigInt::add_n(std::span<const BigInt> left, std::span<const BigInt> right, std::span<BigInt> result)
+{
+    check_batch_sizes(left.size(), right.size(), result.size());
+
+    bigint_detail::parallel_for(left.size(), batch_block::capacity, [&](size_t begin, size_t end)
+                                {
+        batch_block block;
+        if (block.gather(left, right, begin, end))
+        {
+            limb low[batch_block::capacity], high[batch_block::capacity];
+            unsigned char negative[batch_block::capacity];
+            for (size_t i = 0; i < block.size; ++i) // branch-free so the loop vectorizes across elements
+            {
+                limb x = block.left[i], y = block.right[i];
+                limb sum = x + y;
+                bool same_sign = block.left_negative[i] == block.right_negative[i];
+                bool left_larger = x >= y;
+                limb difference = left_larger ? x - y : y - x;
+                low[i] = same_sign ? sum : difference;
+                high[i] = same_sign ? static_cast<limb>(sum < x) : 0;
+                negative[i] = (same_sign || left_larger) ? block.left_negative[i] : block.right_negative[i];
+            }
+            for (size_t i = 0; i < block.size; ++i)
+                result[begin + i].assign_two_limbs(low[i], high[i], negative[i] != 0);
+            return;
+        }
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (&result[i] == &right[i])
+                result[i] += left[i];
+            else
+            {
+                result[i] = left[i];
+                result[i] += right[i];
+            }
+        } });
+}
+
+void BigInt::mul_n(std::span<const BigInt> left, std::span<const BigInt> right, std::span<BigInt> result)
+{
+    check_batch_sizes(left.size(), right.size(), result.size());
+
+    bigint_detail::parallel_for(left.size(), batch_block::capacity, [&](size_t begin, size_t end)
+                                {
+        batch_block block;
+        if (block.gather(left, right, begin, end))
+        {
+            limb low[batch_block::capacity], high[batch_block::capacity];
+            for (size_t i = 0; i < block.size; ++i)
+                low[i] = bigint_detail::mul_wide(block.left[i], block.right[i], high[i]);
+            for (size_t i = 0; i < block.size; ++i)
+                result[begin + i].assign_two_limbs(low[i], high[i], block.left_negative[i] != block.right_negative[i]);
+            return;
+        }
+
+        for (size_t i = begin; i < end; ++i)
+            result[i] = left[i] * right[i]; });
+}
+
+void BigInt::mod_n(std::span<const BigInt> left, std::span<const BigInt> right, std::span<BigInt> result)
+{
+    check_batch_sizes(left.size(), right.size(), result.size());
+
+    bigint_detail::parallel_for(left.size(), batch_block::capacity, [&](size_t begin, size_t end)
+                                {
+        batch_block block;
+        if (block.gather(left, right, begin, end))
+        {
+            for (size_t i = 0; i < block.size; ++i)
+            {
+                if (block.right[i] == 0)
+                {
+                    throw std::invalid_argument("Division by zero is not allowed");
+                }
+            }
+            limb remainder[batch_block::capacity];
+            for (size_t i = 0; i < block.size; ++i)
+            {
+                limb r = block.left[i] % block.right[i];
+                remainder[i] = (block.left_negative[i] && r != 0) ? block.right[i] - r : r; // non-negative like the operator %
+            }
+            for (size_t i = 0; i < block.size; ++i)
+                result[begin + i].assign_two_limbs(remainder[i], 0, false);
+            return;
+        }
+
+        for (size_t i = begin; i < end; ++i)
+            result[i] = left[i] % right[i]; });
+}
+
+void BigInt::compare_n(std::span<const BigInt> left, std::span<const BigInt> right, std::span<int> result)
+{
+    check_batch_sizes(left.size(), right.size(), result.size());
+
+    bigint_detail::parallel_for(left.size(), batch_block::capacity, [&](size_t begin, size_t end)
+                                {
+        batch_block block;
+        if (block.gather(left, right, begin, end))
+        {
+            for (size_t i = 0; i < block.size; ++i) // branch-free so the loop vectorizes across elements
+            {
+                limb x = block.left[i], y = block.right[i];
+                int magnitude_order = static_cast<int>(x > y) - static_cast<int>(x < y);
+                int left_sign = block.left_negative[i] ? -1 : 1;
+                int sign_order = static_cast<int>(block.right_negative[i]) - static_cast<int>(block.left_negative[i]);
+                result[begin + i] = (sign_order != 0) ? sign_order : left_sign * magnitude_order;
+            }
+            return;
+        }
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            std::strong_ordering order = left[i] <=> right[i];
+            result[i] = (order < 0) ? -1 : ((order > 0) ? 1 : 0);
+        } });
+}
+
+BigInt BigInt::product_tree(std::span<const BigInt> factors, size_t weight)
+{
+    if (factors.size() == 1)
+        return factors[0];
+
+    if (factors.size() <= 4 || weight <= bigint_detail::karatsuba_threshold) // small nodes are multiplied from left to right, the schoolbook method handles them anyway
+    {
+        BigInt result = factors[0];
+        for (size_t i = 1; i < factors.size(); ++i)
+            result *= factors[i];
+        return result;
+    }
+
+    size_t split = 0;
+    size_t left_weight = 0;
+    while (split < factors.size() - 1 && 2 * left_weight < weight) // the left subtree takes about half of the limbs
+    {
+        left_weight += factors[split].magnitude.size() + 1;
+        ++split;
+    }
+    if (split == 0)
+    {
+        split = 1;
+        left_weight = factors[0].magnitude.size() + 1;
+    }
+
+    BigInt left, right;
+    auto left_product = [&]
+    { left = product_tree(factors.first(split), left_weight); };
+    auto right_product = [&]
+    { right = product_tree(factors.subspan(split), weight - left_weight); };
+
+    if (bigint_detail::thread_pool *pool = bigint_detail::pool_for(weight / 2))
+        pool->invoke(left_product, right_product);
+    else
+    {
+        left_product();
+        right_product();
+    }
+
+    return left * right;
+}
 
-    /**
-     * @brief Overloads the post-increment operator (X++) for BigInt class
-     * The function creates a copy of (*this) and increments (*this) by 1 using the logic of the overloaded operator '+'
-     * the function returns the original (pre-increment) value of (*this)
-     *
-     *@param int  is a parameter to differentiate post-increment from pre-increment
-     * @return BigInt  a BigInt object representing the original value of (*this)
-     */
+BigInt BigInt::product(std::span<const BigInt> factors)
+{
+    if (factors.empty())
+        return BigInt(1);
 
-    BigInt operator++(int);
+    size_t weight = 0;
+    for (const BigInt &factor : factors)
+        weight += factor.magnitude.size() + 1;
 
-    /**
-     * @brief Overloads the pre-decrement operator (--X) for BigInt class
-     * Uses the logic of the overloaded operator `-`  to decrement the current BigInt object (*this) by 1
-     * the function returns the decremented value of *this
-     *
-     * @return BigInt& A reference to the updated BigInt object (*this)
-     */
+    return product_tree(factors, weight);
+}
 
-    BigInt &operator--();
+BigInt BigInt::sum(std::span<const BigInt> terms)
+{
+    const size_t block = 1024;
+    std::vector<BigInt> partial_sums((terms.size() + block - 1) / block);
+
+    bigint_detail::parallel_for(terms.size(), block, [&](size_t begin, size_t end)
+                                {
+        BigInt &partial = partial_sums[begin / block];
+        for (size_t i = begin; i < end; ++i)
+            partial += terms[i]; });
+
+    BigInt total;
+    for (const BigInt &partial : partial_sums)
+        total += partial;
+    return total;
+}
 
-    /**
-     * @brief Overloads the post-decrement operator (X--) for BigInt class
-     * The function creates a copy of (*this) and decrements (*this) by 1 using the logic of the overloaded operator  `-`
-     * the function returns the original (pre-decrement) value of (*this)
-     *
-     * @param int is a parameter to differentiate post-decrement from pre-decrement
-     * @return BigInt a BigInt object representing the original value of (*this)
-     */
+BigInt BigInt::range_product(uint64_t low, uint64_t high)
+{
+    if (high - low < 32)
+    {
+        BigInt result(1);
+        for (uint64_t k = low; k <= high; ++k)
+        {
+            limb carry = bigint_detail::kernels().mul_1(result.magnitude.data(), result.magnitude.data(), result.magnitude.size(), k);
+            if (carry != 0)
+                result.magnitude.push_back(carry);
+        }
+        return result;
+    }
 
-    BigInt operator--(int);
+    uint64_t middle = low + (high - low) / 2;
+    BigInt left, right;
+    auto left_product = [&]
+    { left = range_product(low, middle); };
+    auto right_product = [&]
+    { right = range_product(middle + 1, high); };
+
+    size_t bits_per_factor = 64 - static_cast<size_t>(bigint_detail::count_leading_zeros(high));
+    size_t estimated_limbs = static_cast<size_t>((high - low) / 2) * bits_per_factor / 64; // the size of each half of the product
+    if (bigint_detail::thread_pool *pool = bigint_detail::pool_for(estimated_limbs))
+        pool->invoke(left_product, right_product);
+    else
+    {
+        left_product();
+        right_product();
+    }
 
-    /**
-     * @brief Overloads the insertion operator (<<) for BigInt class
-     * Streams a BigInt object to an output stream, formatting it with the sign ('+' or '-') followed by its numerical part
-     *
-     * @param out The output stream that the BigInt object will be written to
-     * @param bigint The BigInt object to be output
-     * @return std::ostream& A reference to the modified output stream
-     */
+    return left * right;
+}
 
-    friend std::ostream &operator<<(std::ostream &out, const BigInt &bigint);
+BigInt BigInt::factorial(uint64_t n)
+{
+    if (n < 2)
+        return BigInt(1);
 
-private:
-    /**
-     * @brief Private members of the BigInt class
-     * number Stores the numerical part of a BigInt object which is in string format
-     * sign Stores the sign of a BigInt object as a character ('+' or '-')
-     *
-     */
+    return range_product(2, n);
+}
 
-    std::string number;
-    char sign;
+BigInt BigInt::pow(const BigIntView &base, uint64_t exponent)
+{
+    if (exponent == 0)
+        return BigInt(1);
+    BigInt value(base);
+    if (value.magnitude.empty() || exponent == 1)
+        return value;
+
+    // the squaring for the prefix p of the exponent works on about p / 2 times the limbs of the base and Karatsuba costs about size^1.585, so p^1.585 weighs the progress of each step
+    int top = static_cast<int>(std::bit_width(exponent)) - 1;
+    double total = 0;
+    for (int bit = top - 1; bit >= 0; --bit)
+        total += std::pow(static_cast<double>(exponent >> bit), 1.585);
+
+    BigInt result = value;
+    for (int bit = top - 1; bit >= 0; --bit)
+    {
+        bigint_detail::task_step(std::pow(static_cast<double>(exponent >> bit), 1.585) / total, [&]
+                                 {
+                                     result = result * result;
+                                     if (((exponent >> bit) & 1) != 0)
+                                         result = result * value; });
+    }
+    return result;
+}
 
-    /**
-     * @brief Trims and validates the string input for constructing a valid BigInt object
-     * First Removes leading zeros and spaces to ensure the input is well-formatted.
-     * Then, checks the input for invalid characters ,if any invalid character is found an exception is thrown
-     *
-     * @param main_number The input string for trimming and validation process
-     */
+template <typename Executor>
+std::future<BigInt> BigInt::async_mul(Executor &&executor, BigInt left, BigInt right, std::stop_token stop, std::function<void(double)> progress)
+{
+    return bigint_detail::launch_task<BigInt>(std::forward<Executor>(executor), std::move(stop), std::move(progress), [left = std::move(left), right = std::move(right)]
+                                              { return left * right; });
+}
 
-    void check_number(std::string &main_number);
+template <typename Executor>
+std::future<BigInt> BigInt::async_pow(Executor &&executor, BigInt base, uint64_t exponent, std::stop_token stop, std::function<void(double)> progress)
+{
+    return bigint_detail::launch_task<BigInt>(std::forward<Executor>(executor), std::move(stop), std::move(progress), [base = std::move(base), exponent]
+                                              { return pow(base, exponent); });
+}
 
-    /**
-     * @brief Splits the input string into the sign and numerical value for a BigInt object
-     * Receives a well-formatted input string passed from check_number() and splits it into the sign and the numerical part
-     * This process facilitates the implementation of operators overloading to focus only on the numerical value without interruption from the sign
-     *
-     * @param raw_number the input string for splitting sign and number
-     */
+template <typename Engine>
+BigInt BigInt::random_bits(uint64_t bits, Engine &engine)
+{
+    static_assert(std::uniform_random_bit_generator<Engine> && Engine::min() == 0 && Engine::max() == ~limb{0}, "random_bits needs an engine of uniform 64-bit values, such as std::mt19937_64");
 
-    void split_sign_and_number(std::string &raw_number);
-};
+    BigInt result;
+    size_t limbs = static_cast<size_t>((bits + 63) / 64);
+    if (limbs == 0)
+        return result;
+    result.magnitude.resize(limbs);
+    bigint_detail::fill_random(result.magnitude.data(), limbs, engine);
+    if (bits % 64 != 0)
+        result.magnitude[limbs - 1] &= (limb{1} << (bits % 64)) - 1;
+    result.trim();
+    return result;
+}
 
-BigInt::BigInt()
+template <typename Engine>
+BigInt BigInt::random_below(const BigIntView &bound, Engine &engine)
 {
+    static_assert(std::uniform_random_bit_generator<Engine> && Engine::min() == 0 && Engine::max() == ~limb{0}, "random_below needs an engine of uniform 64-bit values, such as std::mt19937_64");
+    if (bound.limbs.empty() || bound.sign == '-')
+    {
+        throw std::invalid_argument("The bound of random_below must be positive");
+    }
 
-    number = "0";
-    sign = '+';
+    size_t limbs = bound.limbs.size();
+    limb top_bound = bound.limbs[limbs - 1];
+    limb top_mask = ~limb{0} >> std::countl_zero(top_bound);
+    BigInt result;
+    result.magnitude.resize(limbs);
+    limb *candidate = result.magnitude.data();
+    while (true)
+    {
+        // a candidate is uniform over [0, 2^bit_length(bound)), and drawing the lower limbs only when the top limb leaves the comparison open does not change which candidates are accepted
+        limb top = engine() & top_mask;
+        if (top > top_bound)
+            continue;
+        candidate[limbs - 1] = top;
+        bigint_detail::fill_random(candidate, limbs - 1, engine);
+        if (top < top_bound || bigint_mpn::compare(std::span<const limb>(candidate, limbs), bound.limbs) < 0)
+            break;
+    }
+    result.trim();
+    return result;
 }
 
-BigInt::BigInt(int64_t int_num)
+template <typename Executor>
+std::future<std::string> BigInt::async_to_string(Executor &&executor, BigInt value, unsigned base, std::stop_token stop, std::function<void(double)> progress)
 {
-    std::string temp = std::to_string(int_num); // to_string() from cppreference.com is a numeric conversion which converts an integral or floating-point value to string
+    check_base(base); // a bad base throws right away instead of through the future
+    return bigint_detail::launch_task<std::string>(std::forward<Executor>(executor), std::move(stop), std::move(progress), [value = std::move(value), base]
+                                                   { return value.to_string(base); });
+}
 
-    split_sign_and_number(temp);
+uint64_t BigInt::read_serial_header(std::span<const std::byte> header, bool &negative)
+{
+    if (header.size() < 16)
+    {
+        throw std::invalid_argument("Serialized BigInt is truncated");
+    }
+    if (std::memcmp(header.data(), "BIGN", 4) != 0)
+    {
+        throw std::invalid_argument("Serialized BigInt has an invalid magic");
+    }
+    if (std::to_integer<unsigned>(header[4]) != 1)
+    {
+        throw std::invalid_argument("Serialized BigInt has an unsupported version");
+    }
+
+    unsigned sign_byte = std::to_integer<unsigned>(header[5]);
+    if (sign_byte > 1 || header[6] != std::byte{0} || header[7] != std::byte{0})
+    {
+        throw std::invalid_argument("Serialized BigInt has an invalid header");
+    }
+    negative = (sign_byte == 1);
+
+    uint64_t count = 0;
+    for (int i = 7; i >= 0; --i) // the limb count is little-endian
+        count = (count << 8) | std::to_integer<uint64_t>(header[8 + static_cast<size_t>(i)]);
+
+    if (negative && count == 0)
+    {
+        throw std::invalid_argument("Serialized BigInt has an invalid header");
+    }
+    return count;
 }
 
-BigInt::BigInt(const std::string &str_num)
+size_t BigInt::serialized_size() const
 {
-    std::string temp = str_num;
+    return 16 + magnitude.size() * sizeof(limb);
+}
 
-    check_number(temp);
-    split_sign_and_number(temp);
+void BigInt::write_serial_header(std::byte *header) const
+{
+    std::memcpy(header, "BIGN", 4);
+    header[4] = std::byte{1}; // version
+    header[5] = std::byte{static_cast<unsigned char>((sign == '-' && !magnitude.empty()) ? 1 : 0)};
+    header[6] = std::byte{0};
+    header[7] = std::byte{0};
+    uint64_t count = magnitude.size();
+    for (size_t i = 0; i < 8; ++i) // the limb count is little-endian
+        header[8 + i] = std::byte{static_cast<unsigned char>(count >> (8 * i))};
 }
 
-void BigInt::split_sign_and_number(std::string &raw_number)
+void BigInt::serialize(std::span<std::byte> buffer) const
 {
-    if (raw_number == "0" || raw_number == "+0" || raw_number == "-0")
+    if (buffer.size() < serialized_size())
     {
-        sign = '+';
-        number = "0";
+        throw std::invalid_argument("Buffer is too small for the serialized BigInt");
+    }
+
+    write_serial_header(buffer.data());
+    std::byte *limb_bytes = buffer.data() + 16;
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        if (!magnitude.empty())
+            std::memcpy(limb_bytes, magnitude.data(), magnitude.size() * sizeof(limb));
     }
     else
     {
-        if (raw_number[0] == '-' || raw_number[0] == '+')
-        {
-            sign = raw_number[0];
-            number = raw_number.substr(1);
-        }
-        else
-        {
-            sign = '+';
-            number = raw_number;
-        }
+        for (size_t i = 0; i < magnitude.size(); ++i)
+            for (size_t b = 0; b < 8; ++b)
+                limb_bytes[8 * i + b] = std::byte{static_cast<unsigned char>(magnitude[i] >> (8 * b))};
     }
 }
 
-// find_first_not_of() from cppreference.com is a member function of std::string ,it finds the first character equal to none of the characters in the given character sequence
-void BigInt::check_number(std::string &main_number)
+std::vector<std::byte> BigInt::serialize() const
 {
-    std::size_t non_space_position = main_number.find_first_not_of(' '); // it finds the first position in the string that is not a space (' ')
-    if (non_space_position == std::string::npos)                         // If all characters are spaces, the function returns std::string::npos, indicating input is all spaces
+    std::vector<std::byte> buffer(serialized_size());
+    serialize(buffer);
+    return buffer;
+}
+
+void BigInt::serialize(std::ostream &out) const
+{
+    std::byte header[16];
+    write_serial_header(header);
+    out.write(reinterpret_cast<const char *>(header), 16);
+
+    if constexpr (std::endian::native == std::endian::little)
     {
-        throw std::invalid_argument("Input is empty ");
+        out.write(reinterpret_cast<const char *>(magnitude.data()), static_cast<std::streamsize>(magnitude.size() * sizeof(limb)));
     }
-    main_number = main_number.substr(non_space_position);
+    else
+    {
+        std::vector<std::byte> bytes = serialize();
+        out.write(reinterpret_cast<const char *>(bytes.data() + 16), static_cast<std::streamsize>(bytes.size() - 16));
+    }
+}
 
-    std::size_t non_zero_position = main_number.find_first_not_of('0'); // it finds first position in the string that is not a zero ('0')
-    if (non_zero_position == std::string::npos)                         // If all characters are zeros, the function returns std::string::npos and  string is set to "0"
+BigInt BigInt::deserialize(std::span<const std::byte> buffer)
+{
+    bool negative = false;
+    uint64_t count = read_serial_header(buffer, negative);
+    if (count > (buffer.size() - 16) / sizeof(limb))
     {
+        throw std::invalid_argument("Serialized BigInt is truncated");
+    }
 
-        main_number = "0";
+    BigInt result;
+    result.magnitude.resize(static_cast<size_t>(count));
+    const std::byte *limb_bytes = buffer.data() + 16;
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        if (count != 0)
+            std::memcpy(result.magnitude.data(), limb_bytes, static_cast<size_t>(count) * sizeof(limb));
     }
     else
     {
-        main_number = main_number.substr(non_zero_position);
+        for (size_t i = 0; i < result.magnitude.size(); ++i)
+            for (size_t b = 8; b > 0; --b)
+                result.magnitude[i] = (result.magnitude[i] << 8) | std::to_integer<limb>(limb_bytes[8 * i + b - 1]);
     }
 
-    if (main_number.find_first_not_of("0123456789+-") != std::string::npos) // it checks the trimmed input string to find any character that is not part of the valid set (0123456789+-)
+    if (count != 0 && result.magnitude.back() == 0)
     {
-        throw std::invalid_argument("Input contains invalid characters");
+        throw std::invalid_argument("Serialized BigInt has a zero top limb");
     }
+    result.sign = negative ? '-' : '+';
+    return result;
 }
 
-std::string BigInt::getnumber() const
+BigInt BigInt::deserialize(std::istream &in)
 {
-    return number;
+    std::byte header[16];
+    if (!in.read(reinterpret_cast<char *>(header), 16))
+    {
+        throw std::invalid_argument("Serialized BigInt is truncated");
+    }
+    bool negative = false;
+    uint64_t count = read_serial_header(std::span<const std::byte>(header, 16), negative);
+
+    BigInt result;
+    const uint64_t block = uint64_t{1} << 20; // the limbs are read in blocks, so a corrupted count fails at the end of the stream instead of allocating everything up front
+    while (result.magnitude.size() < count)
+    {
+        size_t done = result.magnitude.size();
+        size_t next = static_cast<size_t>(std::min<uint64_t>(count - done, block));
+        result.magnitude.resize(done + next);
+        if (!in.read(reinterpret_cast<char *>(result.magnitude.data() + done), static_cast<std::streamsize>(next * sizeof(limb))))
+        {
+            throw std::invalid_argument("Serialized BigInt is truncated");
+        }
+    }
+
+    if constexpr (std::endian::native != std::endian::little)
+    {
+        for (limb &value : result.magnitude)
+        {
+            limb swapped = 0;
+            for (size_t b = 0; b < 8; ++b)
+                swapped = (swapped << 8) | ((value >> (8 * b)) & 0xff);
+            value = swapped;
+        }
+    }
+
+    if (count != 0 && result.magnitude.back() == 0)
+    {
+        throw std::invalid_argument("Serialized BigInt has a zero top limb");
+    }
+    result.sign = negative ? '-' : '+';
+    return result;
 }
 
-char BigInt::getsign() const
+BigIntView::BigIntView(const BigInt &bigint) : limbs(bigint.magnitude), sign(bigint.magnitude.empty() ? '+' : bigint.sign)
 {
-    return sign;
 }
 
-void BigInt::setsign(char ch)
+BigIntView::BigIntView(char sign_char, std::span<const uint64_t> limb_array) : limbs(limb_array), sign(sign_char)
 {
-    sign = ch;
+    while (!limbs.empty() && limbs.back() == 0)
+        limbs = limbs.first(limbs.size() - 1);
+    if (limbs.empty())
+        sign = '+';
 }
 
-void BigInt::setnumber(const std::string &str)
+BigIntView BigIntView::from_bytes(std::span<const std::byte> buffer)
 {
-    size_t start_position = str.find_first_not_of('0'); // remove leading zeros which are created in operations before set the number
-    if (start_position == std::string::npos)
+    bool negative = false;
+    uint64_t count = BigInt::read_serial_header(buffer, negative);
+    if (count > (buffer.size() - 16) / sizeof(uint64_t))
     {
-        number = "0";
+        throw std::invalid_argument("Serialized BigInt is truncated");
     }
-    else
+    if constexpr (std::endian::native != std::endian::little)
+    {
+        throw std::invalid_argument("Zero-copy views of serialized BigInts need a little-endian machine");
+    }
+    if (reinterpret_cast<std::uintptr_t>(buffer.data() + 16) % alignof(uint64_t) != 0)
+    {
+        throw std::invalid_argument("Buffer is not aligned for a zero-copy view");
+    }
+
+    std::span<const uint64_t> limb_array(reinterpret_cast<const uint64_t *>(buffer.data() + 16), static_cast<size_t>(count));
+    if (count != 0 && limb_array.back() == 0)
     {
-        number = str.substr(start_position);
+        throw std::invalid_argument("Serialized BigInt has a zero top limb");
     }
+    return BigIntView(negative ? '-' : '+', limb_array);
 }
 
-size_t BigInt::getsize() const
+char BigIntView::getsign() const
 {
-    return number.size();
+    return sign;
 }
 
-BigInt BigInt::abs() const
+std::span<const uint64_t> BigIntView::getlimbs() const
 {
-    BigInt temp = *this;
-    temp.setsign('+');
-    return temp;
+    return limbs;
 }
 
-bool BigInt::operator==(const BigInt &operand) const
+std::string BigIntView::getnumber() const
 {
+    return BigInt::magnitude_to_digits(limbs, 10);
+}
 
-    if (getsign() != operand.getsign())
-        return false;
+size_t BigIntView::getsize() const
+{
+    return BigInt::decimal_digits(limbs);
+}
 
-    if (getsize() != operand.getsize())
-        return false;
+size_t BigIntView::serialized_size() const
+{
+    return 16 + limbs.size() * sizeof(uint64_t);
+}
 
-    if (getnumber().compare(operand.getnumber()) == 0) // compare() is a member function from cppreference.com compares two strings, char by char and return < , > and ==
-        return true;
-    else
-        return false;
+BigInt operator+(const BigIntView &left, const BigIntView &right)
+{
+    BigInt result(left);
+    result.add_signed(right.limbs, right.sign);
+    return result;
 }
 
-bool BigInt::operator!=(const BigInt &operand) const
+BigInt operator-(const BigIntView &left, const BigIntView &right)
 {
-    return !(*this == operand);
+    BigInt result(left);
+    result.add_signed(right.limbs, (right.sign == '+') ? '-' : '+');
+    return result;
 }
 
-bool BigInt::operator>(const BigInt &operand) const
+BigInt operator*(const BigIntView &left, const BigIntView &right)
 {
+    return BigInt::multiply(left, right);
+}
 
-    if ((getsign() == '+') && (operand.getsign() == '-'))
-        return true;
-    if ((getsign() == '-') && (operand.getsign() == '+'))
-        return false;
+BigInt operator/(const BigIntView &left, const BigIntView &right)
+{
+    return BigInt::divide(left, right);
+}
 
-    if ((getsign() == '+') && (operand.getsign() == '+'))
-    {
-        if (getsize() > operand.getsize())
-            return true;
-        else if (getsize() < operand.getsize())
-            return false;
+BigInt operator%(const BigIntView &left, const BigIntView &right)
+{
+    return BigInt::modulo(left, right);
+}
 
-        if (getsize() == operand.getsize())
-        {
-            if (getnumber().compare(operand.getnumber()) > 0)
-                return true;
-            else
-                return false;
-        }
+bool operator==(const BigIntView &left, const BigIntView &right)
+{
+    return BigInt::compare(left, right) == 0;
+}
+
+std::strong_ordering operator<=>(const BigIntView &left, const BigIntView &right)
+{
+    return BigInt::compare(left, right);
+}
+
+std::ostream &operator<<(std::ostream &out, const BigIntView &view)
+{
+    out << view.sign << view.getnumber();
+    return out;
+}
+
+BigIntAccumulator::BigIntAccumulator() : pending(0)
+{
+}
+
+void BigIntAccumulator::column_sum::add(std::span<const uint64_t> limbs)
+{
+    if (low.size() < limbs.size())
+    {
+        low.resize(limbs.size());
+        carries.resize(limbs.size());
     }
 
-    if ((getsign() == '-') && (operand.getsign() == '-'))
+    // no carry chain: the carry out of every column is counted next to it, so the loop has no dependency between limbs
+    uint64_t *low_data = low.data();
+    uint64_t *carry_data = carries.data();
+    for (size_t i = 0; i < limbs.size(); ++i)
     {
-        if (getsize() < operand.getsize())
-            return true;
-        else if (getsize() > operand.getsize())
-            return false;
+        uint64_t sum = low_data[i] + limbs[i];
+        carry_data[i] += static_cast<uint64_t>(sum < limbs[i]);
+        low_data[i] = sum;
+    }
+}
 
-        if (getsize() == operand.getsize())
-        {
-            if (getnumber().compare(operand.getnumber()) < 0)
-                return true;
-            else
-                return false;
-        }
+void BigIntAccumulator::column_sum::add(const column_sum &other)
+{
+    add(other.low);
+    for (size_t i = 0; i < other.carries.size(); ++i)
+        carries[i] += other.carries[i];
+}
+
+std::vector<uint64_t> BigIntAccumulator::column_sum::resolve() const
+{
+    // low + carries * 2^64 fits in low.size() + 2 limbs because every counter is below 2^63
+    std::vector<uint64_t> limbs(low.size() + 2);
+    std::copy(low.begin(), low.end(), limbs.begin());
+    if (!carries.empty())
+    {
+        std::span<uint64_t> shifted = std::span<uint64_t>(limbs).subspan(1);
+        bigint_mpn::add(shifted, shifted, carries);
     }
+    return limbs;
+}
 
-    return false;
+void BigIntAccumulator::column_sum::fold()
+{
+    std::vector<uint64_t> limbs = resolve();
+    limbs.resize(bigint_mpn::normalized_size(limbs));
+    low = std::move(limbs);
+    carries.assign(low.size(), 0);
 }
 
-bool BigInt::operator<(const BigInt &operand) const
+void BigIntAccumulator::count_additions(uint64_t additions)
 {
-    if (operand > *this)
+    pending += additions;
+    if (pending >= (1ULL << 62))
     {
-        return true;
+        positive.fold();
+        negative.fold();
+        pending = 0;
     }
+}
+
+BigIntAccumulator &BigIntAccumulator::operator+=(const BigIntView &value)
+{
+    if (value.getsign() == '-')
+        negative.add(value.getlimbs());
+    else
+        positive.add(value.getlimbs());
+    count_additions(1);
+    return *this;
+}
+
+BigIntAccumulator &BigIntAccumulator::operator-=(const BigIntView &value)
+{
+    if (value.getsign() == '-')
+        positive.add(value.getlimbs());
     else
+        negative.add(value.getlimbs());
+    count_additions(1);
+    return *this;
+}
+
+void BigIntAccumulator::merge(const BigIntAccumulator &other)
+{
+    if (this == &other)
     {
-        return false;
+        BigIntAccumulator copy = other;
+        merge(copy);
+        return;
     }
+    positive.add(other.positive);
+    negative.add(other.negative);
+    count_additions(other.pending + 1);
 }
 
-bool BigInt::operator>=(const BigInt &operand) const
+BigInt BigIntAccumulator::value() const
 {
-    if (*this > operand || *this == operand)
-        return true;
-    return false;
+    std::vector<uint64_t> positive_limbs = positive.resolve();
+    std::vector<uint64_t> negative_limbs = negative.resolve();
+    return BigIntView('+', positive_limbs) - BigIntView('+', negative_limbs);
 }
 
-bool BigInt::operator<=(const BigInt &operand) const
+void BigIntAccumulator::clear()
 {
-    if (*this < operand || *this == operand)
-        return true;
-
-    return false;
+    std::fill(positive.low.begin(), positive.low.end(), 0);
+    std::fill(positive.carries.begin(), positive.carries.end(), 0);
+    std::fill(negative.low.begin(), negative.low.end(), 0);
+    std::fill(negative.carries.begin(), negative.carries.end(), 0);
+    pending = 0;
 }
 
-BigInt BigInt::operator+(const BigInt &operand) const
+Rational::Rational() : numerator(), denominator(1), reduced(true), reduced_limbs(1)
 {
-    std::string left_number = getnumber();
-    std::string right_number = operand.getnumber();
-    char left_sign = getsign();
-    char right_sign = operand.getsign();
-    BigInt result("0");
+}
 
-    std::string sum = "";
-    int64_t carry = 0;
-    int64_t diff = 0;
-    int64_t digit_sum = 0;
+Rational::Rational(const int64_t integer) : numerator(integer), denominator(1), reduced(true), reduced_limbs(limb_count(numerator) + 1)
+{
+}
 
-    while (left_number.size() < right_number.size())
-        left_number.insert(left_number.begin(), '0');
-    while (right_number.size() < left_number.size())
-        right_number.insert(right_number.begin(), '0');
+Rational::Rational(const BigInt &integer) : numerator(integer), denominator(1), reduced(true), reduced_limbs(limb_count(numerator) + 1)
+{
+}
 
-    if (left_sign == right_sign)
+Rational::Rational(const BigInt &numerator_value, const BigInt &denominator_value) : numerator(numerator_value), denominator(denominator_value), reduced(false), reduced_limbs(0)
+{
+    if (denominator == BigInt())
     {
-        for (size_t i = left_number.size(); i > 0; --i)
-        {
-            digit_sum = (static_cast<int64_t>(left_number[i - 1] - '0')) + (static_cast<int64_t>(right_number[i - 1] - '0')) + carry; // static_cast<> is used to explicitly convert a value to a specific type and resolve implicit conversion errors reported by the compiler
-            carry = digit_sum / 10;
-            sum.insert(sum.begin(), static_cast<char>((digit_sum % 10) + '0'));
-        }
-
-        if (carry > 0)
-            sum.insert(sum.begin(), static_cast<char>(carry + '0'));
-
-        result.setnumber(sum);
-        result.setsign(left_sign);
-        return result;
+        throw std::invalid_argument("Division by zero is not allowed");
     }
-
-    if (left_sign == '+' && right_sign == '-')
+    if (denominator.getsign() == '-')
     {
-        if (left_number >= right_number)
-        {
-            for (size_t i = left_number.size(); i > 0; --i)
-            {
-                diff = (static_cast<int64_t>(left_number[i - 1] - '0')) - (static_cast<int64_t>(right_number[i - 1] - '0')) - carry;
-                carry = 0;
-
-                if (diff < 0)
-                {
-                    diff += 10;
-                    carry = 1;
-                }
-
-                sum.insert(sum.begin(), static_cast<char>(diff + '0'));
-            }
-
-            result.setnumber(sum);
-            result.setsign(left_sign);
-            return result;
-        }
-        else
-        {
-            for (size_t i = right_number.size(); i > 0; --i)
-            {
-                diff = (static_cast<int64_t>(right_number[i - 1] - '0')) - (static_cast<int64_t>(left_number[i - 1] - '0')) - carry;
-                carry = 0;
+        numerator = -numerator;
+        denominator = -denominator;
+    }
+    if (numerator == BigInt())
+        denominator = BigInt(1);
+    reduced = (denominator == BigInt(1));
+    reduced_limbs = limb_count(numerator) + limb_count(denominator);
+}
 
-                if (diff < 0)
-                {
-                    diff += 10;
-                    carry = 1;
-                }
+size_t Rational::limb_count(const BigInt &value)
+{
+    return BigIntView(value).getlimbs().size();
+}
 
-                sum.insert(sum.begin(), static_cast<char>(diff + '0'));
-            }
+size_t Rational::bit_length(const BigInt &value)
+{
+    std::span<const uint64_t> limbs = BigIntView(value).getlimbs();
+    if (limbs.empty())
+        return 0;
+    return 64 * limbs.size() - static_cast<size_t>(std::countl_zero(limbs.back()));
+}
 
-            result.setnumber(sum);
-            result.setsign(right_sign);
-            return result;
-        }
+void Rational::normalize()
+{
+    if (reduced)
+        return;
+    BigInt common = BigInt::gcd(numerator, denominator);
+    if (common != BigInt(1))
+    {
+        numerator = BigInt::divexact(numerator, common);
+        denominator = BigInt::divexact(denominator, common);
     }
+    reduced = true;
+    reduced_limbs = limb_count(numerator) + limb_count(denominator);
+}
 
-    else if (left_sign == '-' && right_sign == '+')
-    {
-        if (left_number >= right_number)
-        {
-            for (size_t i = left_number.size(); i > 0; --i)
-            {
-                diff = (static_cast<int64_t>(left_number[i - 1] - '0')) - (static_cast<int64_t>(right_number[i - 1] - '0')) - carry;
-                carry = 0;
+void Rational::settle()
+{
+    if (numerator == BigInt())
+        denominator = BigInt(1);
+    reduced = (denominator == BigInt(1));
+    size_t limbs = limb_count(numerator) + limb_count(denominator);
+    if (reduced)
+        reduced_limbs = limbs;
+    else if (limbs > std::max(2 * reduced_limbs, reduce_threshold))
+        normalize();
+}
 
-                if (diff < 0)
-                {
-                    diff += 10;
-                    carry = 1;
-                }
+Rational Rational::from_parts(BigInt numerator_value, BigInt denominator_value)
+{
+    Rational result;
+    result.numerator = std::move(numerator_value);
+    result.denominator = std::move(denominator_value);
+    result.reduced = (result.denominator == BigInt(1));
+    return result;
+}
 
-                sum.insert(sum.begin(), static_cast<char>(diff + '0'));
-            }
+BigInt Rational::getnumerator() const
+{
+    if (reduced)
+        return numerator;
+    return BigInt::divexact(numerator, BigInt::gcd(numerator, denominator));
+}
 
-            result.setnumber(sum);
-            result.setsign(left_sign);
-            return result;
-        }
-        else
-        {
-            for (size_t i = right_number.size(); i > 0; --i)
-            {
-                diff = (static_cast<int64_t>(right_number[i - 1] - '0')) - (static_cast<int64_t>(left_number[i - 1] - '0')) - carry;
-                carry = 0;
+BigInt Rational::getdenominator() const
+{
+    if (reduced)
+        return denominator;
+    return BigInt::divexact(denominator, BigInt::gcd(numerator, denominator));
+}
 
-                if (diff < 0)
-                {
-                    diff += 10;
-                    carry = 1;
-                }
+bool Rational::isinteger() const
+{
+    return denominator == BigInt(1) || BigInt::divisible_by(numerator, denominator);
+}
 
-                sum.insert(sum.begin(), static_cast<char>(diff + '0'));
-            }
+Rational Rational::operator+(const Rational &operand) const
+{
+    Rational result = *this;
+    result += operand;
+    return result;
+}
 
-            result.setnumber(sum);
-            result.setsign(right_sign);
-            return result;
-        }
-    }
+Rational Rational::operator-(const Rational &operand) const
+{
+    Rational result = *this;
+    result -= operand;
+    return result;
+}
 
+Rational Rational::operator*(const Rational &operand) const
+{
+    Rational result = *this;
+    result *= operand;
     return result;
 }
 
-BigInt &BigInt::operator+=(const BigInt &operand)
+Rational Rational::operator/(const Rational &operand) const
+{
+    Rational result = *this;
+    result /= operand;
+    return result;
+}
+
+Rational &Rational::operator+=(const Rational &operand)
 {
-    *this = *this + operand;
+    if (denominator == operand.denominator) // also covers two integers, no cross products are needed
+        numerator += operand.numerator;
+    else
+    {
+        numerator = numerator * operand.denominator + operand.numerator * denominator;
+        denominator *= operand.denominator;
+    }
+    settle();
     return *this;
 }
 
-BigInt BigInt::operator-(const BigInt &operand) const
+Rational &Rational::operator-=(const Rational &operand)
 {
+    *this += -operand;
+    return *this;
+}
 
-    return *this + (-operand);
+Rational &Rational::operator*=(const Rational &operand)
+{
+    numerator *= operand.numerator;
+    denominator *= operand.denominator;
+    settle();
+    return *this;
 }
 
-BigInt &BigInt::operator-=(const BigInt &operand)
+Rational &Rational::operator/=(const Rational &operand)
 {
-    *this = *this - operand;
+    if (operand.numerator == BigInt())
+    {
+        throw std::invalid_argument("Division by zero is not allowed");
+    }
+    BigInt divisor_numerator = operand.denominator;
+    BigInt divisor_denominator = operand.numerator;
+    if (divisor_denominator.getsign() == '-')
+    {
+        divisor_numerator = -divisor_numerator;
+        divisor_denominator = -divisor_denominator;
+    }
+    *this *= from_parts(std::move(divisor_numerator), std::move(divisor_denominator));
     return *this;
 }
 
-BigInt BigInt::operator-() const
+Rational Rational::operator-() const
 {
-    BigInt negated = *this;
+    Rational negated = *this;
+    negated.numerator = -negated.numerator;
+    return negated;
+}
 
-    if (negated.getsign() == '+')
-        negated.setsign('-');
-    else
-        negated.setsign('+');
+std::strong_ordering Rational::operator<=>(const Rational &operand) const
+{
+    // the signs decide first, since both denominators are positive
+    int left_sign = (numerator == BigInt()) ? 0 : (numerator.getsign() == '-' ? -1 : 1);
+    int right_sign = (operand.numerator == BigInt()) ? 0 : (operand.numerator.getsign() == '-' ? -1 : 1);
+    if (left_sign != right_sign || left_sign == 0)
+        return left_sign <=> right_sign;
+
+    // |a| d and |c| b lie in [2^(la + ld - 2), 2^(la + ld)) and [2^(lc + lb - 2), 2^(lc + lb)), so the bit lengths often decide without a multiplication
+    size_t left_bits = bit_length(numerator) + bit_length(operand.denominator);
+    size_t right_bits = bit_length(operand.numerator) + bit_length(denominator);
+    if (left_bits + 1 < right_bits)
+        return (left_sign > 0) ? std::strong_ordering::less : std::strong_ordering::greater;
+    if (right_bits + 1 < left_bits)
+        return (left_sign > 0) ? std::strong_ordering::greater : std::strong_ordering::less;
+
+    if (denominator == operand.denominator)
+        return numerator <=> operand.numerator;
+    return (numerator * operand.denominator) <=> (operand.numerator * denominator);
+}
 
-    return negated;
+bool Rational::operator==(const Rational &operand) const
+{
+    if (reduced && operand.reduced) // reduced fractions are equal only if their parts are
+        return numerator == operand.numerator && denominator == operand.denominator;
+    return (*this <=> operand) == 0;
 }
 
-BigInt BigInt::operator*(const BigInt &operand) const
+std::ostream &operator<<(std::ostream &out, const Rational &rational)
 {
-    std::string left_number = getnumber();
-    std::string right_number = operand.getnumber();
-    char left_sign = getsign();
-    char right_sign = operand.getsign();
-    BigInt result("0");
-    char result_sign;
-    int64_t product;
+    Rational reduced = rational; // copies share the limbs, and the copy is the only one that is written
+    reduced.normalize();
+    out << reduced.numerator.getsign() << reduced.numerator.getnumber();
+    if (reduced.denominator != BigInt(1))
+        out << '/' << reduced.denominator.getnumber();
+    return out;
+}
 
-    if (left_sign == right_sign)
-        result_sign = '+';
-    else
-        result_sign = '-';
+DecimalBigInt::DecimalBigInt() : sign('+')
+{
+}
 
-    for (size_t i = right_number.size(); i > 0; --i)
+DecimalBigInt::DecimalBigInt(const int64_t int_number) : sign(int_number < 0 ? '-' : '+')
+{
+    uint64_t value = (int_number < 0) ? 0 - static_cast<uint64_t>(int_number) : static_cast<uint64_t>(int_number);
+    while (value != 0)
     {
-        std::string partial_result;
-        int64_t carry = 0;
-
-        partial_result.append((right_number.size() - i), '0'); // append zero to partial result in each iteration like grade school
+        magnitude.push_back(value % bigint_detail::decimal::base);
+        value /= bigint_detail::decimal::base;
+    }
+}
 
-        for (size_t j = left_number.size(); j > 0; --j)
-        {
+DecimalBigInt::DecimalBigInt(const std::string &str_number)
+{
+    std::string temp = str_number;
+    BigInt().check_number(temp);
 
-            product = (static_cast<int64_t>(left_number[j - 1] - '0')) * (static_cast<int64_t>(right_number[i - 1] - '0')) + carry;
-            carry = product / 10;
-            partial_result.insert(partial_result.begin(), static_cast<char>((product % 10) + '0'));
-        }
+    sign = '+';
+    std::string_view digits(temp);
+    if (digits[0] == '-' || digits[0] == '+')
+    {
+        sign = digits[0];
+        digits.remove_prefix(1);
+    }
+    set_from_digits(digits);
+}
 
-        if (carry > 0)
-        {
-            partial_result.insert(partial_result.begin(), static_cast<char>(carry + '0'));
-        }
+DecimalBigInt::DecimalBigInt(const BigInt &bigint) : sign(bigint.getsign())
+{
+    set_from_digits(bigint.getnumber());
+}
 
-        result = result + BigInt(partial_result);
+void DecimalBigInt::set_from_digits(std::string_view digits)
+{
+    constexpr unsigned width = bigint_detail::decimal::digits_per_limb;
+    magnitude.clear();
+    magnitude.reserve(digits.size() / width + 1);
+    for (size_t end = digits.size(); end > 0;)
+    {
+        size_t begin = (end > width) ? end - width : 0;
+        limb value = 0;
+        for (size_t i = begin; i < end; ++i)
+            value = value * 10 + static_cast<limb>(digits[i] - '0');
+        magnitude.push_back(value);
+        end = begin;
     }
+    trim();
+}
 
-    result.setnumber(result.getnumber());
-    result.setsign(result_sign);
-
+BigInt DecimalBigInt::to_bigint() const
+{
+    BigInt result(getnumber());
+    if (!magnitude.empty())
+        result.setsign(sign);
     return result;
 }
 
-BigInt &BigInt::operator*=(const BigInt &operand)
+void DecimalBigInt::trim()
 {
-    *this = *this * operand;
-    return *this;
+    while (!magnitude.empty() && magnitude.back() == 0)
+        magnitude.pop_back();
+    if (magnitude.empty())
+        sign = '+';
 }
 
-BigInt &BigInt::operator++()
+char DecimalBigInt::getsign() const
 {
-    *this = *this + BigInt("1");
-    return *this;
+    return sign;
 }
 
-BigInt BigInt::operator++(int)
+void DecimalBigInt::setsign(char ch)
 {
-    BigInt result = *this;
-    *this = *this + BigInt("1");
-    return result;
+    sign = ch;
 }
 
-BigInt &BigInt::operator--()
+std::string DecimalBigInt::getnumber() const
 {
-    *this = *this - BigInt("1");
-    return *this;
+    if (magnitude.empty())
+        return "0";
+
+    constexpr unsigned width = bigint_detail::decimal::digits_per_limb;
+    std::string digits = std::to_string(magnitude.back());
+    size_t top_size = digits.size();
+    digits.resize(top_size + (magnitude.size() - 1) * width);
+    char *out = digits.data() + top_size;
+    for (size_t i = magnitude.size() - 1; i > 0; --i) // every lower limb is written with exactly 19 digits, leading zeros included
+    {
+        limb value = magnitude[i - 1];
+        for (unsigned j = width; j > 0; --j)
+        {
+            out[j - 1] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        out += width;
+    }
+    return digits;
 }
 
-BigInt BigInt::operator--(int)
+void DecimalBigInt::setnumber(const std::string &str)
 {
-    BigInt result = *this;
-    *this = *this - BigInt("1");
-    return result;
+    if (str.empty() || str.find_first_not_of("0123456789") != std::string::npos)
+    {
+        throw std::invalid_argument("Input contains invalid characters");
+    }
+    set_from_digits(str);
 }
 
-std::ostream &operator<<(std::ostream &out, const BigInt &bigint)
+size_t DecimalBigInt::getsize() const
 {
-    if (bigint.getsign() == '+')
-        out << "+" << bigint.getnumber();
-    else if (bigint.getsign() == '-')
-        out << "-" << bigint.getnumber();
-    return out;
+    if (magnitude.empty())
+        return 1;
+    size_t top_digits = 1;
+    for (limb value = magnitude.back(); value >= 10; value /= 10)
+        ++top_digits;
+    return (magnitude.size() - 1) * bigint_detail::decimal::digits_per_limb + top_digits;
 }
 
-BigInt BigInt::operator/(const BigInt &operand) const
+DecimalBigInt DecimalBigInt::abs() const
 {
+    DecimalBigInt temp = *this;
+    temp.sign = '+';
+    return temp;
+}
 
-    BigInt dividend = *this;
-    BigInt divisor = operand;
-    BigInt quotient("0");
-    BigInt remainder("0");
-    char newsign;
+int DecimalBigInt::compare_magnitude(const std::vector<limb> &left, const std::vector<limb> &right)
+{
+    return bigint_mpn::compare(left, right); // the limbs of both are below 10^19, so they order like binary limbs
+}
 
-    if (divisor.getsign() == dividend.getsign())
-    {
-        newsign = '+';
-    }
-    else
+void DecimalBigInt::add_signed(const std::vector<limb> &operand, char operand_sign)
+{
+    if (operand.empty())
+        return;
+    if (magnitude.empty())
     {
-        newsign = '-';
+        magnitude = operand;
+        sign = operand_sign;
+        return;
     }
 
-    if (divisor == BigInt("0"))
+    size_t left_size = magnitude.size();
+    size_t right_size = operand.size();
+    if (sign == operand_sign)
     {
-        throw std::invalid_argument("Division by zero is not allowed");
+        if (left_size < right_size)
+            magnitude.resize(right_size, 0);
+        limb carry = bigint_detail::decimal::add(magnitude.data(), magnitude.data(), magnitude.size(), operand.data(), right_size);
+        if (carry != 0)
+            magnitude.push_back(carry);
+        return;
     }
-    else if (dividend == BigInt("0"))
+
+    int order = compare_magnitude(magnitude, operand);
+    if (order == 0)
     {
-        BigInt result("0");
-        result.setsign('+');
-        return result;
+        magnitude.clear();
+        sign = '+';
+        return;
     }
-    else if (dividend.abs() == divisor.abs())
+    if (order > 0)
     {
-        BigInt result("1");
-        result.setsign(newsign);
-        return result;
+        bigint_detail::decimal::sub(magnitude.data(), magnitude.data(), left_size, operand.data(), right_size);
     }
-    else if (divisor.abs() > dividend.abs())
+    else
     {
-        BigInt result("0");
-        result.setsign('+');
-        return result;
+        std::vector<limb> difference(right_size);
+        bigint_detail::decimal::sub(difference.data(), operand.data(), right_size, magnitude.data(), left_size);
+        magnitude = std::move(difference);
+        sign = operand_sign;
     }
+    trim();
+}
 
-    if (dividend.abs() > divisor.abs())
-    {
-
-        for (char div : dividend.getnumber())
-        {
+DecimalBigInt DecimalBigInt::operator+(const DecimalBigInt &operand) const
+{
+    DecimalBigInt result = *this;
+    result.add_signed(operand.magnitude, operand.sign);
+    return result;
+}
 
-            remainder = (remainder * BigInt("10")) + BigInt(std::to_string(div - '0')); // by multiplying the remainder by 10 in each iteration, its value is shifted left by one digit
-            BigInt count("0");
+DecimalBigInt DecimalBigInt::operator-(const DecimalBigInt &operand) const
+{
+    DecimalBigInt result = *this;
+    result.add_signed(operand.magnitude, (operand.sign == '+') ? '-' : '+');
+    return result;
+}
 
-            while (remainder.abs() >= divisor.abs())
-            {
-                remainder -= divisor.abs();
-                count++;
-            }
+DecimalBigInt DecimalBigInt::operator*(const DecimalBigInt &operand) const
+{
+    DecimalBigInt result;
+    if (magnitude.empty() || operand.magnitude.empty())
+        return result;
 
-            quotient = quotient * BigInt("10") + count;
-        }
+    const std::vector<limb> &longer = (magnitude.size() >= operand.magnitude.size()) ? magnitude : operand.magnitude;
+    const std::vector<limb> &shorter = (magnitude.size() >= operand.magnitude.size()) ? operand.magnitude : magnitude;
+    result.magnitude.resize(longer.size() + shorter.size());
+    bigint_detail::decimal::mul(result.magnitude.data(), longer.data(), longer.size(), shorter.data(), shorter.size());
+    result.sign = (sign == operand.sign) ? '+' : '-';
+    result.trim();
+    return result;
+}
 
-        remainder.setsign(dividend.getsign());
-        remainder.setnumber(remainder.getnumber());
-        quotient.setsign(newsign);
-        quotient.setnumber(quotient.getnumber());
+DecimalBigInt DecimalBigInt::operator/(const DecimalBigInt &operand) const
+{
+    if (operand.magnitude.empty())
+    {
+        throw std::invalid_argument("Division by zero is not allowed");
+    }
+    if (operand.magnitude.size() > 1) // long divisors are rare in decimal workloads, the binary backend divides them in O(n^2) with Knuth's algorithm
+        return DecimalBigInt(to_bigint() / operand.to_bigint());
+
+    DecimalBigInt quotient = *this;
+    bigint_detail::decimal::divrem_1(quotient.magnitude.data(), quotient.magnitude.data(), quotient.magnitude.size(), operand.magnitude[0]);
+    quotient.sign = (sign == operand.sign) ? '+' : '-';
+    quotient.trim();
+    return quotient;
+}
 
-        return quotient;
+DecimalBigInt DecimalBigInt::operator%(const DecimalBigInt &operand) const
+{
+    if (operand.magnitude.empty())
+    {
+        throw std::invalid_argument("Division by zero is not allowed");
     }
+    if (operand.magnitude.size() > 1)
+        return DecimalBigInt(to_bigint() % operand.to_bigint());
 
-    return BigInt("0"); 
+    std::vector<limb> quotient(magnitude.size());
+    limb remainder = bigint_detail::decimal::divrem_1(quotient.data(), magnitude.data(), magnitude.size(), operand.magnitude[0]);
+    if (sign == '-' && remainder != 0) // the modulus is never negative, as in BigInt: (-a) mod b = |b| - (a mod |b|)
+        remainder = operand.magnitude[0] - remainder;
+
+    DecimalBigInt modulus;
+    if (remainder != 0)
+        modulus.magnitude.push_back(remainder);
+    return modulus;
 }
 
-BigInt &BigInt::operator/=(const BigInt &operand)
+DecimalBigInt &DecimalBigInt::operator+=(const DecimalBigInt &operand)
+{
+    add_signed(operand.magnitude, operand.sign);
+    return *this;
+}
+
+DecimalBigInt &DecimalBigInt::operator-=(const DecimalBigInt &operand)
+{
+    add_signed(operand.magnitude, (operand.sign == '+') ? '-' : '+');
+    return *this;
+}
+
+DecimalBigInt &DecimalBigInt::operator*=(const DecimalBigInt &operand)
 {
+    *this = *this * operand;
+    return *this;
+}
 
+DecimalBigInt &DecimalBigInt::operator/=(const DecimalBigInt &operand)
+{
     *this = *this / operand;
+    return *this;
+}
 
+DecimalBigInt &DecimalBigInt::operator%=(const DecimalBigInt &operand)
+{
+    *this = *this % operand;
     return *this;
 }
 
-BigInt BigInt::operator%(const BigInt &operand) const
+DecimalBigInt DecimalBigInt::operator-() const
 {
+    DecimalBigInt negated = *this;
+    if (!negated.magnitude.empty())
+        negated.sign = (sign == '+') ? '-' : '+';
+    return negated;
+}
 
-    BigInt quotient = *this / operand;
-    BigInt modulus = *this - (quotient * operand);
+DecimalBigInt &DecimalBigInt::operator++()
+{
+    add_signed({1}, '+');
+    return *this;
+}
 
-    if (modulus.getsign() == '-')
-    {
-        modulus = modulus + operand.abs(); // following the standard mathematical convention to ensure the modulus is non-negative
-    }
+DecimalBigInt DecimalBigInt::operator++(int)
+{
+    DecimalBigInt original = *this;
+    ++*this;
+    return original;
+}
 
-    return modulus;
+DecimalBigInt &DecimalBigInt::operator--()
+{
+    add_signed({1}, '-');
+    return *this;
 }
 
-BigInt &BigInt::operator%=(const BigInt &operand)
+DecimalBigInt DecimalBigInt::operator--(int)
 {
+    DecimalBigInt original = *this;
+    --*this;
+    return original;
+}
 
-    *this = *this % operand;
+bool DecimalBigInt::operator==(const DecimalBigInt &operand) const
+{
+    return sign == operand.sign && magnitude == operand.magnitude;
+}
 
-    return *this;
-}
\ No newline at end of file
+std::strong_ordering DecimalBigInt::operator<=>(const DecimalBigInt &operand) const
+{
+    if (sign != operand.sign)
+        return (sign == '-') ? std::strong_ordering::less : std::strong_ordering::greater;
+    int order = compare_magnitude(magnitude, operand.magnitude);
+    if (sign == '-')
+        order = -order;
+    return order <=> 0;
+}
+
+std::ostream &operator<<(std::ostream &out, const DecimalBigInt &bigint)
+{
+    out << bigint.sign << bigint.getnumber();
+    return out;
+}
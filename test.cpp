@@ -1,6 +1,14 @@
 #include <iostream>
 #include <string>
 #include <stdexcept>
+#include <map>
+#include <unordered_set>
+#include <vector>
+#include <sstream>
+#include <thread>
+#include <future>
+#include <system_error>
+#include <random>
 #include "bigint.hpp"
 using namespace std;
 
@@ -88,6 +96,23 @@ int main()
     cout << "num12 <  num13 : (457892 < 18446744073709551615) ? " << (num12 < num13) << endl;
     cout << "num10 <= num5  : (1267650600228229401496703205376 <= 9223372036854775807) ? " << (num10 <= num5) << endl;
     cout << "num4  >= num11 : (-2147483648 >= -165206) ? " << (num4 >= num11) << endl;
+    cout << "num3 <=> num11 : (-92 <=> -165206) > 0 ? " << ((num3 <=> num11) > 0) << endl;
+    cout << "num14 == -num14 : (0 == -0) ? " << (num14 == -num14) << endl;
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Ordered and unordered containers) ----------------------------------------" << endl
+         << endl;
+
+    std::map<BigInt, int> ordered_keys{{num10, 10}, {num4, 4}, {num8, 8}, {num3, 3}, {num14, 14}};
+    cout << "std::map<BigInt, int> keys in order : ";
+    for (const auto &[key, value] : ordered_keys)
+        cout << key << " ";
+    cout << endl;
+
+    std::unordered_set<BigInt> hashed_keys{num5, num13, BigInt("9223372036854775807"), num14, -num14};
+    cout << "std::unordered_set<BigInt> {num5, num13, 9223372036854775807, 0, -0} size : " << hashed_keys.size() << endl;
+    cout << "std::hash<BigInt>(num5) == std::hash<BigInt>(9223372036854775807) ? " << (std::hash<BigInt>{}(num5) == std::hash<BigInt>{}(BigInt("9223372036854775807"))) << endl;
 
     cout << endl;
 
@@ -178,6 +203,427 @@ int main()
          << (num7 / num2) * num2 + (num7 % num2) << endl;
 
 
+    cout << endl;
+
+    cout << "---------------------------------------- (Multi-limb operations) ----------------------------------------" << endl
+         << endl;
+
+    BigInt power_of_two("1");
+    for (int i = 0; i < 256; ++i)
+        power_of_two *= BigInt(2);
+    cout << "2 power of 256 : " << power_of_two << endl;
+
+    BigInt factorial_30("1");
+    for (int64_t i = 2; i <= 30; ++i)
+        factorial_30 *= BigInt(i);
+    cout << "factorial 30 : " << factorial_30 << endl;
+
+    cout << "(2 power of 256 - 1) / factorial 30 : " << ((power_of_two - BigInt(1)) / factorial_30) << endl;
+    cout << "(2 power of 256 - 1) % factorial 30 : " << ((power_of_two - BigInt(1)) % factorial_30) << endl;
+    cout << "-(2 power of 256) % num9 : " << ((-power_of_two) % num9) << endl;
+    cout << "(2 power of 256 / num10) * num10 + 2 power of 256 % num10 == 2 power of 256 ? " << ((power_of_two / num10) * num10 + power_of_two % num10 == power_of_two) << endl;
+    cout << "number of digits of 2 power of 256 : " << power_of_two.getsize() << endl;
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Parallel multiplication) ----------------------------------------" << endl
+         << endl;
+
+    BigInt large_left("1");
+    BigInt large_right("1");
+    for (int i = 0; i < 6000; ++i) // 3 power of 6000 and 7 power of 5000 are a few thousand digits, large enough for Karatsuba
+        large_left *= BigInt(3);
+    for (int i = 0; i < 5000; ++i)
+        large_right *= BigInt(7);
+
+    BigInt serial_product = large_left * large_right;
+    BigInt::setthreads(4);
+    BigInt::setgrainsize(64);
+    BigInt parallel_product = large_left * large_right;
+    cout << "threads : " << BigInt::getthreads() << " , grain size : " << BigInt::getgrainsize() << " limbs" << endl;
+    cout << "(3 power of 6000) * (7 power of 5000) with 4 threads == with 1 thread ? " << (parallel_product == serial_product) << endl;
+    cout << "(3 power of 6000) * (7 power of 5000) / (7 power of 5000) == 3 power of 6000 ? " << (parallel_product / large_right == large_left) << endl;
+    cout << "number of digits of (3 power of 6000) * (7 power of 5000) : " << parallel_product.getsize() << endl;
+    BigInt::setthreads(1);
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Batch operations) ----------------------------------------" << endl
+         << endl;
+
+    std::vector<BigInt> batch_left{BigInt(650), BigInt(-92), BigInt("18446744073709551615"), BigInt("1267650600228229401496703205376")};
+    std::vector<BigInt> batch_right{BigInt(-650), BigInt(31536000), BigInt("18446744073709551615"), BigInt("2432902008176640000")};
+    std::vector<BigInt> batch_result(batch_left.size());
+    std::vector<int> batch_order(batch_left.size());
+
+    BigInt::add_n(batch_left, batch_right, batch_result);
+    cout << "add_n {650, -92, 18446744073709551615, 2 power of 100} + {-650, 31536000, 18446744073709551615, factorial 20} : ";
+    for (const BigInt &element : batch_result)
+        cout << element << " ";
+    cout << endl;
+
+    BigInt::mul_n(batch_left, batch_right, batch_result);
+    cout << "mul_n {650, -92, 18446744073709551615, 2 power of 100} * {-650, 31536000, 18446744073709551615, factorial 20} : ";
+    for (const BigInt &element : batch_result)
+        cout << element << " ";
+    cout << endl;
+
+    BigInt::mod_n(batch_left, batch_right, batch_result);
+    cout << "mod_n {650, -92, 18446744073709551615, 2 power of 100} % {-650, 31536000, 18446744073709551615, factorial 20} : ";
+    for (const BigInt &element : batch_result)
+        cout << element << " ";
+    cout << endl;
+
+    BigInt::compare_n(batch_left, batch_right, batch_order);
+    cout << "compare_n {650, -92, 18446744073709551615, 2 power of 100} <=> {-650, 31536000, 18446744073709551615, factorial 20} : ";
+    for (int order : batch_order)
+        cout << order << " ";
+    cout << endl;
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Product and sum of many operands) ----------------------------------------" << endl
+         << endl;
+
+    std::vector<BigInt> one_to_fifty;
+    for (int64_t i = 1; i <= 50; ++i)
+        one_to_fifty.push_back(BigInt(i));
+
+    cout << "product(1, 2, ..., 50) : " << BigInt::product(one_to_fifty) << endl;
+    cout << "factorial(50) : " << BigInt::factorial(50) << endl;
+    cout << "sum(1, 2, ..., 50) : " << BigInt::sum(one_to_fifty) << endl;
+    cout << "product({}) , sum({}) : " << BigInt::product({}) << " , " << BigInt::sum({}) << endl;
+
+    std::vector<BigInt> mixed_terms{num5, num13, -num10, num9, num4};
+    cout << "sum(9223372036854775807, 18446744073709551615, -2 power of 100, factorial 20, -2147483648) : " << BigInt::sum(mixed_terms) << endl;
+    cout << "product(9223372036854775807, 18446744073709551615, -2 power of 100, factorial 20, -2147483648) : " << BigInt::product(mixed_terms) << endl;
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Binary serialization and views) ----------------------------------------" << endl
+         << endl;
+
+    std::vector<std::byte> bytes = num10.serialize();
+    cout << "serialized_size(2 power of 100) : " << num10.serialized_size() << " bytes" << endl;
+    cout << "deserialize(serialize(2 power of 100)) : " << BigInt::deserialize(bytes) << endl;
+
+    std::stringstream checkpoint;
+    num4.serialize(checkpoint);
+    BigInt().serialize(checkpoint);
+    cout << "deserialize stream (-2147483648, 0) : " << BigInt::deserialize(checkpoint) << " , " << BigInt::deserialize(checkpoint) << endl;
+
+    std::vector<uint64_t> mapped((bytes.size() + 7) / 8); // stands in for an 8-byte aligned memory-mapped file
+    std::memcpy(mapped.data(), bytes.data(), bytes.size());
+    BigIntView view = BigIntView::from_bytes(std::as_bytes(std::span(mapped)));
+    cout << "view of the serialized 2 power of 100 : " << view << " (" << view.getlimbs().size() << " limbs, " << view.getsize() << " digits)" << endl;
+    cout << "view + 9223372036854775807 : " << (view + num5) << endl;
+    cout << "view * view : " << (view * view) << endl;
+    cout << "view % 31536000 : " << (view % num7) << endl;
+    cout << "view == 2 power of 100 , view > 2 power of 100 : " << (view == num10) << " , " << (view > num10) << endl;
+
+    try
+    {
+        bytes[0] = std::byte{'X'};
+        BigInt::deserialize(bytes);
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cerr << "Error: " << e.what() << endl;
+    }
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Conversion to and from other bases) ----------------------------------------" << endl
+         << endl;
+
+    cout << "18446744073709551615 in base 16 : " << num13.to_string(16) << endl;
+    cout << "-2147483648 in base 2 : " << num4.to_string(2) << endl;
+    cout << "2 power of 100 in base 8 : " << num10.to_string(8) << endl;
+    cout << "2 power of 100 in base 36 : " << num10.to_string(36) << endl;
+    cout << "BigInt(\"-7FFFFFFFFFFFFFFF\", 16) : " << BigInt("-7FFFFFFFFFFFFFFF", 16) << endl;
+    cout << "BigInt(\"  zz\", 36) , BigInt(\"0000101\", 2) , BigInt(\"-120\", 3) : " << BigInt("  zz", 36) << " , " << BigInt("0000101", 2) << " , " << BigInt("-120", 3) << endl;
+    cout << "round trip of 2 power of 100 in base 7 : " << (BigInt(num10.to_string(7), 7) == num10) << endl;
+
+    try
+    {
+        BigInt("12g", 16);
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cerr << "Error: " << e.what() << endl;
+    }
+
+    try
+    {
+        num2.to_string(37);
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cerr << "Error: " << e.what() << endl;
+    }
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Conversion to native types) ----------------------------------------" << endl
+         << endl;
+
+    cout << "to_int64(-2147483648) , to_int64(9223372036854775807) : " << num4.to_int64() << " , " << num5.to_int64() << endl;
+    cout << "to_uint64(18446744073709551615) : " << num13.to_uint64() << endl;
+    cout << "to_double(2 power of 100) : " << num10.to_double() << endl;
+    cout << "to_long_double(factorial 20) : " << num9.to_long_double() << endl;
+
+    BigInt beyond_double(1); // 2 power of 1100 is beyond the range of double
+    for (int i = 0; i < 11; ++i)
+        beyond_double *= num10;
+    int64_t exponent;
+    double mantissa = beyond_double.frexp(exponent);
+    cout << "frexp(2 power of 1100) : " << mantissa << " * 2^" << exponent << " , to_double : " << beyond_double.to_double() << endl;
+
+    cout << "fits_in<int64_t>(18446744073709551615) , fits_in<uint64_t>(18446744073709551615) : " << num13.fits_in<int64_t>() << " , " << num13.fits_in<uint64_t>() << endl;
+    cout << "fits_in<int32_t>(-2147483648) , fits_in<uint32_t>(-2147483648) : " << num4.fits_in<int32_t>() << " , " << num4.fits_in<uint32_t>() << endl;
+    cout << "fits_in<float>(2 power of 100) : " << num10.fits_in<float>() << endl;
+
+    try
+    {
+        num13.to_int64();
+    }
+    catch (const std::out_of_range &e)
+    {
+        std::cerr << "Error: " << e.what() << endl;
+    }
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Low-level limb functions) ----------------------------------------" << endl
+         << endl;
+
+    std::span<const uint64_t> power_limbs = BigIntView(num10).getlimbs();
+    std::span<const uint64_t> max_limbs = BigIntView(num13).getlimbs();
+
+    std::vector<uint64_t> product(power_limbs.size() + max_limbs.size());
+    std::vector<uint64_t> scratch(bigint_mpn::mul_scratch_size(power_limbs.size(), max_limbs.size()));
+    bigint_mpn::mul(product, power_limbs, max_limbs, scratch);
+    cout << "mul(2 power of 100, 18446744073709551615) : " << BigIntView('+', product) << endl;
+
+    std::vector<uint64_t> square(2 * power_limbs.size());
+    scratch.resize(bigint_mpn::sqr_scratch_size(power_limbs.size()));
+    bigint_mpn::sqr(square, power_limbs, scratch);
+    cout << "sqr(2 power of 100) : " << BigIntView('+', square) << endl;
+
+    std::vector<uint64_t> quotient(square.size() - max_limbs.size() + 1), remainder(max_limbs.size());
+    scratch.resize(bigint_mpn::divrem_scratch_size(square.size(), max_limbs.size()));
+    bigint_mpn::divrem(quotient, remainder, square, max_limbs, scratch);
+    cout << "divrem(2 power of 200, 18446744073709551615) : " << BigIntView('+', quotient) << " , " << BigIntView('+', remainder) << endl;
+
+    uint64_t carry = bigint_mpn::add_n(product, product, product); // the same buffers are reused, nothing is allocated
+    cout << "add_n(product, product) : " << BigIntView('+', product) << " carry " << carry << endl;
+    cout << "compare(2 power of 100, 18446744073709551615) : " << bigint_mpn::compare(power_limbs, max_limbs) << endl;
+
+    try
+    {
+        bigint_mpn::mul(product, power_limbs, power_limbs, scratch);
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cerr << "Error: " << e.what() << endl;
+    }
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Carry-save accumulator) ----------------------------------------" << endl
+         << endl;
+
+    BigIntAccumulator total, other_thread;
+    for (int i = 0; i < 1000; ++i)
+    {
+        total += num10;
+        other_thread -= num5;
+    }
+    cout << "1000 x 2 power of 100 : " << total.value() << endl;
+    total.merge(other_thread);
+    cout << "merged with 1000 x -9223372036854775807 : " << total.value() << endl;
+    total += num4;
+    cout << "+ -2147483648 : " << total.value() << endl;
+    total.clear();
+    cout << "after clear() : " << total.value() << endl;
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Exact division and divisibility) ----------------------------------------" << endl
+         << endl;
+
+    BigInt factorial40 = BigInt::factorial(40);
+    cout << "divexact(40!, 20!) : " << BigInt::divexact(factorial40, num9) << endl;
+    cout << "divexact(-1000 x 2 power of 100, 2 power of 100) : " << BigInt::divexact(num10 * BigInt(-1000), num10) << endl;
+    cout << "divisible_by(40!, 20!) , divisible_by(2 power of 100, 20!) : " << BigInt::divisible_by(factorial40, num9) << " , " << BigInt::divisible_by(num10, num9) << endl;
+    BigInt factorial3000 = BigInt::factorial(3000), factorial1500 = BigInt::factorial(1500); // hundreds of limbs, cleared a block at a time
+    cout << "divisible_by(3000!, 1500!) , divisible_by(3000!, 1500! x 3001) : " << BigInt::divisible_by(factorial3000, factorial1500) << " , " << BigInt::divisible_by(factorial3000, factorial1500 * BigInt(3001)) << endl;
+    cout << "divexact(3000!, 1500!) == 3000! / 1500! : " << (BigInt::divexact(factorial3000, factorial1500) == factorial3000 / factorial1500) << endl;
+    BigInt fibonacci100("354224848179261915075");
+    cout << "divisible_by_word(fibonacci 100, 570601) , divisible_by_word(fibonacci 100, 7) : " << BigInt::divisible_by_word(fibonacci100, 570601) << " , " << BigInt::divisible_by_word(fibonacci100, 7) << endl;
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Greatest common divisor and rational numbers) ----------------------------------------" << endl
+         << endl;
+
+    cout << "gcd(40!, 2 power of 100) : " << BigInt::gcd(factorial40, num10) << endl;
+    cout << "gcd(-2147483648, 0) : " << BigInt::gcd(num4, BigInt()) << endl;
+
+    Rational third(BigInt(1), BigInt(3)), sixth(BigInt(-1), BigInt(-6));
+    cout << "1/3 + 1/6 : " << (third + sixth) << endl;
+    cout << "1/3 - 1/6 * 4 : " << (third - sixth * Rational(4)) << endl;
+    cout << "(1/3) / (1/6) : " << (third / sixth) << " , isinteger : " << (third / sixth).isinteger() << endl;
+    cout << "2 power of 100 / 20! : " << Rational(num10, num9) << endl;
+
+    Rational harmonic;
+    for (int k = 1; k <= 30; ++k)
+        harmonic += Rational(BigInt(1), BigInt(k));
+    cout << "1 + 1/2 + ... + 1/30 : " << harmonic << endl;
+    const Rational shared_fraction(BigInt::factorial(30), BigInt::factorial(20) * BigInt(7)); // not reduced, the readers must not reduce it in place
+    std::string printed_by_thread;
+    std::thread fraction_reader([&]()
+                                { std::ostringstream text; text << shared_fraction << " " << shared_fraction.getdenominator(); printed_by_thread = text.str(); });
+    std::ostringstream printed_here;
+    printed_here << shared_fraction << " " << shared_fraction.getdenominator();
+    fraction_reader.join();
+    cout << "30! / (7 x 20!) read from two threads : " << printed_here.str() << " , same : " << (printed_here.str() == printed_by_thread) << endl;
+    cout << "1/3 < 2/5 , 2/6 == 1/3 : " << (third < Rational(BigInt(2), BigInt(5))) << " , " << (Rational(BigInt(2), BigInt(6)) == third) << endl;
+
+    try
+    {
+        cout << third / Rational() << endl;
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cerr << "Error: " << e.what() << endl;
+    }
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Decimal-limb backend) ----------------------------------------" << endl
+         << endl;
+
+    BasicBigInt<Base10Limbs> ledger("   000123456789012345678901234567890");
+    BasicBigInt<Base2Limbs> binary_ledger("123456789012345678901234567890");
+    cout << "ledger : " << ledger << " (" << ledger.getsize() << " digits)" << endl;
+    ledger += BasicBigInt<Base10Limbs>("-9999999999999999999");
+    binary_ledger += BigInt("-9999999999999999999");
+    cout << "ledger - 9999999999999999999 : " << ledger << " , binary backend : " << binary_ledger << endl;
+    cout << "ledger * ledger : " << (ledger * ledger) << endl;
+    cout << "ledger / 100 , ledger % 100 : " << (ledger / DecimalBigInt(100)) << " , " << (ledger % DecimalBigInt(100)) << endl;
+    cout << "-ledger % 18446744073709551615 : " << (-ledger % DecimalBigInt("18446744073709551615")) << endl;
+    cout << "DecimalBigInt(2 power of 100).to_bigint() == 2 power of 100 : " << (DecimalBigInt(num10).to_bigint() == num10) << endl;
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Copy-on-write magnitudes) ----------------------------------------" << endl
+         << endl;
+
+    BigInt original = factorial40;
+    BigInt modified = original;
+    modified += BigInt(1);
+    cout << "copy of 40! after += 1 : " << modified << endl;
+    cout << "40! is unchanged : " << original << endl;
+    cout << "-(40!) , abs(-(40!)) : " << -original << " , " << (-original).abs() << endl;
+
+    std::vector<BigInt> copies(3, original);
+    copies[1] *= BigInt(2);
+    cout << "copies after copies[1] *= 2 : " << copies[0] << " , " << copies[1] << " , " << copies[2] << endl;
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Power and asynchronous operations) ----------------------------------------" << endl
+         << endl;
+
+    cout << "pow(-2, 5) , pow(10, 30) , pow(0, 0) : " << BigInt::pow(BigInt(-2), 5) << " , " << BigInt::pow(BigInt(10), 30) << " , " << BigInt::pow(BigInt(0), 0) << endl;
+
+    auto run_inline = [](std::function<void()> job)
+    { job(); };
+    std::vector<double> progress;
+    BigInt power_3 = BigInt::pow(BigInt(3), 100000), power_7 = BigInt::pow(BigInt(7), 80000);
+    std::future<BigInt> product_future = BigInt::async_mul(run_inline, power_3, power_7, {}, [&progress](double done)
+                                                           { progress.push_back(done); });
+    cout << "async_mul(3 power of 100000, 7 power of 80000) == product : " << (product_future.get() == power_3 * power_7) << endl;
+    cout << "progress reported , increasing , ends at 1 : " << (progress.size() > 10) << " , " << std::is_sorted(progress.begin(), progress.end()) << " , " << progress.back() << endl;
+
+    std::vector<std::jthread> workers;
+    auto run_on_thread = [&workers](std::function<void()> job)
+    { workers.emplace_back(std::move(job)); };
+    std::future<BigInt> power_future = BigInt::async_pow(run_on_thread, BigInt(3), 100000);
+    std::future<std::string> digits_future = BigInt::async_to_string(run_on_thread, power_7, 16);
+    cout << "async_pow(3, 100000) on a thread == pow(3, 100000) : " << (power_future.get() == power_3) << endl;
+    cout << "async_to_string(7 power of 80000, 16) on a thread == to_string(16) : " << (digits_future.get() == power_7.to_string(16)) << endl;
+
+    std::stop_source stop;
+    stop.request_stop();
+    std::future<BigInt> cancelled_future = BigInt::async_pow(run_inline, BigInt(3), 100000, stop.get_token());
+    try
+    {
+        cancelled_future.get();
+    }
+    catch (const std::system_error &e)
+    {
+        cout << "async_pow with a stopped token throws operation_canceled : " << (e.code() == std::errc::operation_canceled) << endl;
+    }
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Random numbers) ----------------------------------------" << endl
+         << endl;
+
+    std::mt19937_64 engine(2024);
+    cout << "random_bits(100) : " << BigInt::random_bits(100, engine) << endl;
+    cout << "random_below(10 power of 30) : " << BigInt::random_below(BigInt::pow(BigInt(10), 30), engine) << endl;
+
+    std::vector<int> histogram(6, 0);
+    for (int i = 0; i < 6000; ++i)
+        ++histogram[static_cast<size_t>(BigInt::random_below(BigInt(6), engine).to_int64())];
+    cout << "6000 draws of random_below(6) , every value 900 to 1100 times : " << std::all_of(histogram.begin(), histogram.end(), [](int count)
+                                                                                              { return count > 900 && count < 1100; })
+         << endl;
+
+    std::mt19937_64 serial_engine(7), parallel_engine(7);
+    BigInt serial_random = BigInt::random_bits(20000000, serial_engine);
+    BigInt::setthreads(4);
+    BigInt parallel_random = BigInt::random_bits(20000000, parallel_engine);
+    BigInt::setthreads(1);
+    cout << "random_bits(20000000) with 4 threads == with 1 thread : " << (serial_random == parallel_random) << endl;
+
+    try
+    {
+        BigInt::random_below(BigInt(0), engine);
+    }
+    catch (const std::invalid_argument &e)
+    {
+        cerr << "Error: " << e.what() << endl;
+    }
+
+    cout << endl;
+
+    cout << "---------------------------------------- (Stream extraction operator) ----------------------------------------" << endl
+         << endl;
+
+    std::istringstream input("  -2147483648 +0000299792458\n1267650600228229401496703205376 12abc");
+    BigInt read1, read2, read3, read4;
+    input >> read1 >> read2 >> read3 >> read4;
+    cout << "input >> : " << read1 << " , " << read2 << " , " << read3 << " , " << read4 << endl;
+
+    std::string rest;
+    input >> rest;
+    cout << "characters left in the stream : " << rest << endl;
+
+    BigInt unchanged(650);
+    std::istringstream not_a_number("-x");
+    not_a_number >> unchanged;
+    cout << "input >> for \"-x\" : failed = " << not_a_number.fail() << " , value kept = " << unchanged << endl;
+
+    std::string many_digits(2000, '9'); // 10^2000 - 1, long enough for the divide-and-conquer conversion
+    std::istringstream long_input(many_digits);
+    BigInt read_long;
+    long_input >> read_long;
+    cout << "input >> 2000 nines, then + 1 == 10 power of 2000 : " << (read_long + BigInt(1) == BigInt("1" + std::string(2000, '0'))) << endl;
+
     cout << endl;
 
     cout << "---------------------------------------- (Increment and Decrement Operators) ----------------------------------------" << endl
@@ -0,0 +1,65 @@
+#include <iostream>
+#include <string>
+#define BIGINT_INSTRUMENTATION // this file checks the counters, test.cpp builds the default configuration
+#include "bigint.hpp"
+using namespace std;
+
+int main()
+{
+    std::cout << std::boolalpha;
+
+    cout << "---------------------------------------- (Instrumentation) ----------------------------------------" << endl
+         << endl;
+
+    BigInt factorial40 = BigInt::factorial(40);
+
+    BigInt::resetstats();
+    BigInt big_square = factorial40 * factorial40;
+    BigInt wide(std::string(2000, '7'));
+    BigInt wide_square = wide * wide;
+    BigInt wide_product = wide * factorial40;
+    BigInt wide_quotient = wide / factorial40;
+    BigInt wide_remainder = wide % BigInt(1000);
+    wide_product += wide_square;
+
+    size_t events = 0;
+    BigInt::setstatshook([&events](const BigIntEvent &event)
+                         { events += (event.op == BigIntOp::print) ? 1 : 0; });
+    std::string printed = wide_quotient.to_string();
+    BigInt::setstatshook(nullptr);
+
+    BigIntStats stats = BigInt::getstats();
+    for (BigIntOp op : {BigIntOp::add, BigIntOp::multiply, BigIntOp::square, BigIntOp::divide, BigIntOp::modulo, BigIntOp::parse, BigIntOp::print})
+    {
+        cout << BigIntStats::name(op) << " : " << stats.total_calls(op) << " calls , tiers";
+        for (size_t tier = 0; tier < BigIntStats::tier_count; ++tier)
+            if (stats.tier_calls(op, static_cast<BigIntTier>(tier)) != 0)
+                cout << " " << BigIntStats::name(static_cast<BigIntTier>(tier)) << " = " << stats.tier_calls(op, static_cast<BigIntTier>(tier));
+        cout << endl;
+    }
+    uint64_t square_bucket = stats.calls[static_cast<size_t>(BigIntOp::square)][BigIntStats::bucket(104)];
+    cout << "square calls of 64 to 127 limbs (bucket " << BigIntStats::bucket(104) << ") : " << square_bucket << endl;
+    cout << "print events seen by the hook : " << events << endl;
+    cout << "magnitude bytes were allocated : " << (stats.bytes_allocated > 0) << endl;
+
+    // the counts printed above, so CTest fails when one of them changes
+    bool expected = stats.total_calls(BigIntOp::add) == 1 && stats.total_calls(BigIntOp::multiply) == 1 && stats.total_calls(BigIntOp::square) == 2 &&
+                    stats.tier_calls(BigIntOp::square, BigIntTier::karatsuba) == 1 && stats.total_calls(BigIntOp::divide) == 1 &&
+                    stats.tier_calls(BigIntOp::modulo, BigIntTier::single_limb) == 1 && stats.tier_calls(BigIntOp::parse, BigIntTier::divide_and_conquer) == 1 &&
+                    stats.total_calls(BigIntOp::print) == 1 && square_bucket == 1 && events == 1 && stats.bytes_allocated > 0;
+
+    BigInt::resetstats();
+    BigIntStats cleared = BigInt::getstats();
+    expected = expected && cleared.total_calls(BigIntOp::square) == 0 && cleared.bytes_allocated == 0;
+
+    cout << endl;
+
+    cout << "-----------------------------------------------------------------------------------------------------------------------" << endl;
+
+    if (!expected)
+    {
+        cerr << "Error: the instrumentation counters differ from the expected values" << endl;
+        return 1;
+    }
+    return 0;
+}